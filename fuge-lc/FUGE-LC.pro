@@ -16,6 +16,7 @@ QT += core xml widgets concurrent
 include(libGGA/libGGA.pri)
 include(fuzzy/Fuzzy.pri)
 include(coev/Coev.pri)
+include(dataset/Dataset.pri)
 include(Dependencies/duktape/duktape.pri)
 
 SOURCES += main.cpp \
@@ -3,8 +3,10 @@ DEPENDPATH += $$PWD
 
 SOURCES += $$PWD/coevcooperator.cpp \
     $$PWD/coevolution.cpp \
-    $$PWD/coevstats.cpp
+    $$PWD/coevstats.cpp \
+    $$PWD/runstate.cpp
     
 HEADERS += $$PWD/coevcooperator.h \
     $$PWD/coevolution.h \
-    $$PWD/coevstats.h
+    $$PWD/coevstats.h \
+    $$PWD/runstate.h
@@ -36,11 +36,53 @@ int counterCoops = 0;
   *
   * @param ComputeThread::fSystem Pointer to an existing fuzzy system
   */
-CoEvolution::CoEvolution(FuzzySystem *fSystem, QMutex *access, QSemaphore *standby, Population *left, Population *right, quint32 generationCount, qreal crossoverProbability, qreal mutationProbability, qreal mutationPerBitProbability, quint32 eliteSize, quint32 cooperatorsCount, QObject *parent) : EvolutionEngine(left, generationCount, crossoverProbability, mutationProbability, mutationPerBitProbability), QThread(parent), fSystem(fSystem), access(access), standby(standby), eliteSize(eliteSize), left(left), right(right), generationCount(generationCount), cooperatorsCount(cooperatorsCount)
+CoEvolution::CoEvolution(FuzzySystem *fSystem, Population *left, Population *right, quint32 generationCount, qreal crossoverProbability, qreal mutationProbability, qreal mutationPerBitProbability, quint32 eliteSize, quint32 cooperatorsCount, QObject *parent) : EvolutionEngine(left, generationCount, crossoverProbability, mutationProbability, mutationPerBitProbability), QThread(parent), fSystem(fSystem), eliteSize(eliteSize), left(left), right(right), generationCount(generationCount), cooperatorsCount(cooperatorsCount)
 {
     isFirst = true;
     needToSave = false;
     fileName.clear();
+
+    // Genomes decoded by calcFitness(), reused for all the evaluations
+    membGen = new FuzzyMembershipsGenome(fSystem->getNbInVars(),fSystem->getNbOutVars(),
+                                         fSystem->getNbInSets(),fSystem->getNbOutSets(),
+                                         fSystem->getInSetsPosCodeSize(), fSystem->getOutSetsPosCodeSize());
+    ruleGenTab.resize(fSystem->getNbRules());
+    for (int i = 0; i < ruleGenTab.size(); i++) {
+        ruleGenTab[i] = new FuzzyRuleGenome(fSystem->getNbVarPerRule(), fSystem->getNbInVars(),fSystem->getNbOutVars(),
+                                            fSystem->getInVarsCodeSize(),fSystem->getOutVarsCodeSize(),
+                                            fSystem->getInSetsCodeSize(), fSystem->getOutSetsCodeSize());
+    }
+
+    const bool memberships = (left->getName() == "MEMBERSHIPS");
+    membershipsIntegerCoded = (memberships ? left : right)->isIntegerCoded();
+    rulesIntegerCoded = (memberships ? right : left)->isIntegerCoded();
+
+    // Blocks exchanged by the RuleAligned crossover : the rules and the default rules,
+    // or the membership functions of each variable. An integer coded genotype has a
+    // gene per position, variable number or set number.
+    const int geneSize = left->isIntegerCoded() ? BitString::GENE_BITS : 1;
+    QVector<int> blockStarts;
+    if (memberships) {
+        const int inVarSize = fSystem->getNbInSets()*(left->isIntegerCoded() ? geneSize : fSystem->getInSetsPosCodeSize());
+        const int outVarSize = fSystem->getNbOutSets()*(left->isIntegerCoded() ? geneSize : fSystem->getOutSetsPosCodeSize());
+        for (int i = 0; i < fSystem->getNbInVars(); i++)
+            blockStarts.append(i*inVarSize);
+        for (int i = 0; i < fSystem->getNbOutVars(); i++)
+            blockStarts.append(fSystem->getNbInVars()*inVarSize + i*outVarSize);
+    }
+    else {
+        const int ruleSize = left->isIntegerCoded() ? fSystem->getRuleGeneCount()*geneSize : fSystem->getRuleBitStringSize();
+        for (int i = 0; i <= fSystem->getNbRules(); i++)
+            blockStarts.append(i*ruleSize);
+    }
+    addCrossoverMethod(new RuleAligned(blockStarts));
+
+    // The genes of an integer coded genotype are never cut, and mutated within their range
+    if (left->isIntegerCoded()) {
+        for (quint32 i = 0; i < getCrossoverMethods().size(); i++)
+            getCrossoverMethods().at(i)->setGeneSize(geneSize);
+        addMutationMethod(new RandomResetting(left->getGeneRanges()));
+    }
 }
 
 /**
@@ -48,6 +90,8 @@ CoEvolution::CoEvolution(FuzzySystem *fSystem, QMutex *access, QSemaphore *stand
  */
 CoEvolution::~CoEvolution()
 {
+    delete membGen;
+    qDeleteAll(ruleGenTab);
 }
 
 /**
@@ -57,11 +101,51 @@ void CoEvolution::run(){
     // Command the verbose output print
     qDebug() << "RUN : " << left->getName() << " : left_getsize : " << left->getSize();
 
+    // Crossover selected by the script for this population
+    const QString crossoverName = (left->getName() == "MEMBERSHIPS") ? ComputeThread::sysParams->getCrossoverPop1()
+                                                                     : ComputeThread::sysParams->getCrossoverPop2();
+    Crossover *crossover = getCrossoverMethod(crossoverName);
+    if (crossover == NULL) {
+        std::cout << "Error : unknown crossover " << crossoverName.toStdString() << ", "
+                  << getCrossoverMethods().at(0)->getName().toStdString() << " is used" << std::endl;
+        crossover = getCrossoverMethods().at(0);
+    }
+
+    // Selection of the individuals to be reproduced
+    const bool memberships = (left->getName() == "MEMBERSHIPS");
+    const QString selectionName = memberships ? ComputeThread::sysParams->getSelectionPop1()
+                                              : ComputeThread::sysParams->getSelectionPop2();
+    EntitySelection *selection = getEntitySelector(selectionName);
+    if (selection == NULL || selection == getEntitySelectors().at(0)) {
+        std::cout << "Error : unknown selection " << selectionName.toStdString() << ", "
+                  << getEntitySelectors().at(1)->getName().toStdString() << " is used" << std::endl;
+        selection = getEntitySelectors().at(1);
+    }
+    setTournamentSize(memberships ? ComputeThread::sysParams->getTournamentSizePop1()
+                                  : ComputeThread::sysParams->getTournamentSizePop2());
+
+    setDiversityTarget(ComputeThread::sysParams->getDiversityTarget());
+    plateauFitness = 0.0;
+    plateauGeneration = 0;
+    onPlateau = false;
+    currentGeneration = 0;
+    entityRepresentatives.reset();
+    entityGeneration = 0;
+
+    // Mutation of the coding of the population
+    Mutate *mutation = getMutationMethod(left->isIntegerCoded() ? "RandomResetting" : "Toggling");
+
     //TODO set generation values trough the interface.
-    startEvolution(access,standby, generationCount,
-                   getEntitySelectors().at(0),eliteSize,
-                   getEntitySelectors().at(1),left->getSize()-eliteSize,
-                   getMutationMethods().at(0),getCrossoverMethods().at(0), cooperatorsCount);
+    if (ComputeThread::sysParams->getSteadyState())
+        startSteadyStateEvolution(generationCount,
+                                  getEntitySelectors().at(0),eliteSize,
+                                  selection,left->getSize()-eliteSize,
+                                  mutation,crossover, cooperatorsCount);
+    else
+        startEvolution(generationCount,
+                       getEntitySelectors().at(0),eliteSize,
+                       selection,left->getSize()-eliteSize,
+                       mutation,crossover, cooperatorsCount);
 }
 
 /**
@@ -73,62 +157,93 @@ void CoEvolution::run(){
 bool CoEvolution::evaluatePopulation(Population* population, quint32 generation){
 
     //Evaluate our population with the other cooperators(elites)
-    vector<PopEntity *> leftPopEntities = population->getAllEntities();
-    vector<PopEntity *> RightRepresentative;
-
-    // Due to multithreading representatives from the other population might not be ready.
-    RightRepresentative = right->getRepresentativesCopy();
+    // The generation is evaluated with the representatives selected from the
+    // previous generation of the other population (epoch 1 being the random
+    // one), which may already publish the next ones meanwhile. A steady state
+    // evolution only waits for the first ones, and then takes the last ones.
+    shared_ptr<const RepresentativeSet> RightRepresentative;
+    if (ComputeThread::sysParams->getSteadyState() && !ComputeThread::sysParams->getSteadyStateLockstep())
+        RightRepresentative = right->waitLatestRepresentatives(generation + 1);
+    else
+        RightRepresentative = right->waitRepresentatives(generation + 1);
+    currentGeneration = generation;
 
-    vector<PopEntity *>::iterator itLeftPop, itRepresentative;
-
-    PopEntity *bestCurrGenRepresentative = 0;
-    PopEntity *bestCurrGenLeftPopEntity = 0;
     qreal currentIndBestFit = 0.0;
-    qreal overallBestFit = 0.0;
-    for(itLeftPop=leftPopEntities.begin(); itLeftPop!=leftPopEntities.end(); itLeftPop++)
+    for(quint32 i = 0; i < population->getSize(); i++)
     {
-        currentIndBestFit = 0.0;
-        // Loop through all cooperators
-        for(itRepresentative=RightRepresentative.begin(); itRepresentative!=RightRepresentative.end(); itRepresentative++)
-        {
-            fitness = 0.0;
-            if(left->getName() == "MEMBERSHIPS")
-                calcFitness((*itLeftPop),(*itRepresentative));
-            else
-                calcFitness((*itRepresentative), (*itLeftPop));
-            if (fitness > currentIndBestFit) {
-                currentIndBestFit = fitness;
-                if(fitness > overallBestFit) {
-                    overallBestFit = fitness;
-                    bestCurrGenRepresentative = *itRepresentative;
-                    bestCurrGenLeftPopEntity = *itLeftPop;
-                }
-                (*itLeftPop)->setFitness(fitness); // choose the best fit, between ind & all coops
-            }
-            if(ComputeThread::stop)
-                break;
-        }
+        // choose the best fit, between ind & all coops
+        currentIndBestFit = evaluateCooperation(population->genotypeAt(i), RightRepresentative.get());
+        population->setFitnessAt(i, currentIndBestFit);
         if(currentIndBestFit)
-            getStatisticEngine()->addFitness(fitness);
+            getStatisticEngine()->addFitness(currentIndBestFit);
         if(ComputeThread::stop)
             break;
     }
 
-    // FIXME: HOT fix because the best fuzzy system is the last generation best fuzzy system
-    // which is wrong, but until we continue to use ELITISM it will work.
-    // This should not be needed, instead the whole fuzzy system object should be saved on computeThread !
-    if( bestCurrGenLeftPopEntity )
+    return endGeneration(population, generation);
+}
+
+/**
+ * @brief CoEvolution::evaluateEntity Evaluate a single individual with the last representatives
+ * published by the other population. In lockstep, it is evaluated with the ones published at
+ * the start of the same steady state generation instead, waiting for them at the first child
+ * of the generation.
+ *
+ * @param genotypeData Genotype of an individual of the population
+ * @param generation number of the steady state generation
+ * @return the best fitness of the individual with the representatives
+ */
+qreal CoEvolution::evaluateEntity(const BitString *genotypeData, quint32 generation)
+{
+    if (!ComputeThread::sysParams->getSteadyStateLockstep())
+        return evaluateCooperation(genotypeData, right->waitLatestRepresentatives(1).get());
+
+    if (entityGeneration != generation || !entityRepresentatives) {
+        entityRepresentatives = right->waitRepresentatives(generation + 1);
+        entityGeneration = generation;
+    }
+    return evaluateCooperation(genotypeData, entityRepresentatives.get());
+}
+
+/**
+ * @brief CoEvolution::evaluateCooperation Evaluate an individual with each representative
+ * of the other population.
+ *
+ * @param genotypeData Genotype of an individual of the population
+ * @param representatives Representatives of the other population, may be NULL
+ * @return the best fitness of the individual with the representatives
+ */
+qreal CoEvolution::evaluateCooperation(const BitString *genotypeData, const RepresentativeSet *representatives)
+{
+    const int nbRepresentatives = representatives ? representatives->getSize() : 0;
+    qreal bestFit = 0.0;
+    // Loop through all cooperators
+    for(int k = 0; k < nbRepresentatives; k++)
     {
+        const BitString *representativeGenotype = representatives->genotypeAt(k);
+        fitness = 0.0;
         if(left->getName() == "MEMBERSHIPS")
-            calcFitness(bestCurrGenLeftPopEntity, bestCurrGenRepresentative);
+            calcFitness(genotypeData, representativeGenotype);
         else
-            calcFitness(bestCurrGenRepresentative, bestCurrGenLeftPopEntity);
+            calcFitness(representativeGenotype, genotypeData);
+        if (fitness > bestFit)
+            bestFit = fitness;
+        if(ComputeThread::stop)
+            break;
     }
+    return bestFit;
+}
 
-    // Delete representatives
-    for(int i = 0; i < RightRepresentative.size(); i++)
-        delete RightRepresentative[i];
-
+/**
+ * @brief CoEvolution::endGeneration Report the statistics of a generation and check the
+ * stop conditions.
+ *
+ * @param population Population of the generation
+ * @param generation number of the generation
+ * @return true if the evolution goes on, false if it must stop.
+ */
+bool CoEvolution::endGeneration(Population* population, quint32 generation)
+{
     // Print the output in verbose mode if needed
     if (ComputeThread::sysParams->getVerbose()) {
         std::cout << "verbose (evalop) is " << ComputeThread::sysParams->getVerbose() << std::endl;
@@ -137,105 +252,131 @@ bool CoEvolution::evaluatePopulation(Population* population, quint32 generation)
 
     // Build stats
     statsEngine.buildStats();
+    statsEngine.buildDiversity(population);
     // Plot stats and save fuzzy system
-    ComputeThread::saveSystemStats(population->getName(), statsEngine.getMinFitness(),statsEngine.getMaxFitness(),statsEngine.getMeanFitness(),statsEngine.getStandardDeviation(),population->getSize(), generation);
+    ComputeThread::saveSystemStats(population->getName(), statsEngine.getMinFitness(),statsEngine.getMaxFitness(),statsEngine.getMeanFitness(),statsEngine.getStandardDeviation(),
+                                  statsEngine.getBitEntropy(),statsEngine.getPairDistance(),population->getSize(), generation, getIsland());
+
+    // Best fitness of the generation, for the plateau of this population
+    const qreal generationBestFitness = statsEngine.getMaxFitness();
 
     // Reset stats engine
     statsEngine.reset();
 
     // Stop in case max fitness reached.
-    if( ComputeThread::bestFSystem != NULL && ComputeThread::sysParams != NULL )
+    if( ComputeThread::sysParams != NULL )
     {
         if (left->getName() == "MEMBERSHIPS"){
-            if(ComputeThread::bestFSystem->getFitness() >= ComputeThread::sysParams->getMaxFitPop1())
+            if(ComputeThread::getBestFitness() >= ComputeThread::sysParams->getMaxFitPop1()) {
+                ComputeThread::requestStop("FitnessThreshold", generation);
                 emit fitnessThreshReached();
+            }
         }else{
-            if(ComputeThread::bestFSystem->getFitness() >= ComputeThread::sysParams->getMaxFitPop2())
+            if(ComputeThread::getBestFitness() >= ComputeThread::sysParams->getMaxFitPop2()) {
+                ComputeThread::requestStop("FitnessThreshold", generation);
                 emit fitnessThreshReached();
+            }
+        }
+    }
+
+    // This population is on a plateau when its best fitness has not improved
+    // by more than epsilon for plateauGenerations generations, and it has
+    // converged. The run stops once all its populations are on a plateau.
+    const int plateauGenerations = ComputeThread::sysParams->getPlateauGenerations();
+    if (plateauGenerations > 0) {
+        bool plateau = false;
+        if (generationBestFitness > plateauFitness + ComputeThread::sysParams->getPlateauEpsilon()) {
+            plateauFitness = generationBestFitness;
+            plateauGeneration = generation;
+        }
+        else {
+            plateau = generation - plateauGeneration >= (quint32) plateauGenerations &&
+                    (ComputeThread::sysParams->getPlateauDiversity() <= 0.0 ||
+                     statsEngine.getPairDistance() <= ComputeThread::sysParams->getPlateauDiversity());
+        }
+        if (plateau != onPlateau) {
+            onPlateau = plateau;
+            ComputeThread::reportPlateau(plateau, generation);
         }
     }
 
+    // Save the best system so far when a periodic save is due, the thread
+    // claiming it evaluates the system again on its own fuzzy system
+    if (ComputeThread::claimCheckpoint() && evaluateBestSystem())
+        fSystem->saveToFile(ComputeThread::currentBestFileName(), fitness);
+
+    // The next evaluations of a steady state evolution belong to the next generation
+    currentGeneration = generation + 1;
+
     return !ComputeThread::stop;
 }
 
 
 
+/**
+  * @brief CoEvolution::evaluateBestSystem Evaluate again the couple of genotypes of the best
+  * fuzzy system found, so that the fuzzy system of this coevolution holds it.
+  *
+  * @return false if no fuzzy system has been evaluated yet.
+  */
+bool CoEvolution::evaluateBestSystem()
+{
+    BitString memberships;
+    BitString rules;
+    if (!ComputeThread::getBestGenotypes(memberships, rules))
+        return false;
+    // Not an evaluation of the evolution, it is left out of the budget
+    calcFitness(&memberships, &rules, false);
+    return true;
+}
+
 /**
   * @brief CoEvolution::calcFitness Compute the fitness of a couple of two individuals, which form a fuzzy system. The fuzzy
   * system is evaluated against the dataset.
   *
-  * @param inX Individual of population 1 (membership functions)
-  * @param inY Individual of population 2 (rules)
+  * @param genotypeDataX Genotype of an individual of population 1 (membership functions)
+  * @param genotypeDataY Genotype of an individual of population 2 (rules)
+  * @param counted Whether the evaluation is counted in the evaluations budget
   */
-void CoEvolution::calcFitness(PopEntity *inX, PopEntity *inY)
+void CoEvolution::calcFitness(const BitString *genotypeDataX, const BitString *genotypeDataY, bool counted)
 {
-    Q_ASSERT( inX != NULL && inY != NULL );
-    Genotype* genX = inX->getGenotype();
-    Genotype* genY = inY->getGenotype();
-    if( genX == NULL || genY == NULL )
+    Q_ASSERT( genotypeDataX != NULL && genotypeDataY != NULL );
+    if( genotypeDataX == NULL || genotypeDataY == NULL )
         return;
-    QBitArray *genotypeDataX = genX->getData();
-    QBitArray *genotypeDataY = genY->getData();
-    QVector<quint16> ruleBitString(ComputeThread::ruleGenSize);
-
-    FuzzyMembershipsGenome* membGen = new FuzzyMembershipsGenome(fSystem->getNbInVars(),fSystem->getNbOutVars(),
-                                                fSystem->getNbInSets(),fSystem->getNbOutSets(),
-                                                fSystem->getInSetsPosCodeSize(), fSystem->getOutSetsPosCodeSize());
-    QVector<FuzzyRuleGenome*> ruleGenTab(ComputeThread::nbRules);
-
-    for (int i = 0; i < ComputeThread::nbRules; i++) {
-        ruleGenTab[i] = new FuzzyRuleGenome(fSystem->getNbVarPerRule(), fSystem->getNbInVars(),fSystem->getNbOutVars(),
-                                            fSystem->getInVarsCodeSize(),fSystem->getOutVarsCodeSize(),
-                                            fSystem->getInSetsCodeSize(), fSystem->getOutSetsCodeSize());
-    }
 
     // Read the memberships genome
-    membGen->readGenomeBitString(genotypeDataX, ComputeThread::membersGenSize);
-
-    // Rules genome transcription with FIXED VARS
+    if (membershipsIntegerCoded)
+        membGen->readGenomeGenes(genotypeDataX);
+    else
+        membGen->readGenomeBitString(genotypeDataX, ComputeThread::membersGenSize);
 
-    // FIXME: Fixed vars were never used on any test case provided, is it still necessary ? From : Yvan Da Silva.
-    if (ComputeThread::sysParams->getFixedVars()) {
-        //qDebug() << "FIXED";
-        // Transcript each rule one by one
+    // Read the rules genomes, straight from the genotype. With fixed vars the
+    // variables numbers are not coded in the genotype.
+    int defRulesSize = fSystem->getDefaultRulesBitStringSize();
+    QVector<int> defRules(defRulesSize);
+    if (rulesIntegerCoded) {
+        const int ruleGenes = fSystem->getRuleGeneCount();
         for (int k = 0; k < ComputeThread::nbRules; k++) {
-            // Variables d'entrée : le code des variables d'entrée est toujours 0
-            for (int l = 0; l < ComputeThread::nbVarPerRule; l++) {
-                ruleBitString[l*(ComputeThread::inSetsCodeSize+1)] = 0;
-                for (int m = 1; m < ComputeThread::inSetsCodeSize+1; m++) {
-                    ruleBitString[l*(ComputeThread::inSetsCodeSize+1) + m] = genotypeDataY->at(k*fSystem->getRuleBitStringSize() + (l*ComputeThread::inSetsCodeSize) + m-1);
-                }
-            }
-            // Variables de sortie
-            int outBase = ComputeThread::nbVarPerRule * (ComputeThread::inSetsCodeSize+1);
-            for (int l = 0; l < ComputeThread::nbOutVars; l++) {
-                // Le code des variables de sortie est toujours 0
-                ruleBitString[outBase + l*(ComputeThread::outSetsCodeSize+1)] = 0;
-                for (int m = 1; m < ComputeThread::outSetsCodeSize+1; m++) {
-                    ruleBitString[outBase + l*(ComputeThread::outSetsCodeSize+1) + m] = genotypeDataY->at(k*fSystem->getRuleBitStringSize()
-                                                                                                          + ComputeThread::nbVarPerRule*ComputeThread::inSetsCodeSize + l*ComputeThread::outSetsCodeSize + m-1);
-                }
-            }
-            // Read the rule
-            ruleGenTab[k]->readGenomeBitString(ruleBitString.data(), ComputeThread::ruleGenSize);
+            ruleGenTab[k]->readGenomeGenes(genotypeDataY, k*ruleGenes);
+        }
+        // The default sets are genes, given to the fuzzy system as their bits
+        const int outSetsCodeSize = fSystem->getOutSetsCodeSize();
+        for (int i = 0; i < defRulesSize; i++) {
+            const int set = genotypeDataY->gene(ComputeThread::nbRules*ruleGenes + i/outSetsCodeSize);
+            defRules[i] = (set >> (i % outSetsCodeSize)) & 1;
         }
     }
-    // Genome transcription with EVOLVING VARS
     else {
-        // FIXME: ReadGenomeBitString should be able to decode QbitArray directly avoid this N2 operation. From : Yvan Da Silva.
+        const int ruleSize = fSystem->getRuleBitStringSize();
         for (int k = 0; k < ComputeThread::nbRules; k++) {
-            for (int l = 0; l < ComputeThread::ruleGenSize; l++) {
-                ruleBitString[l] = genotypeDataY->at(l + k*ComputeThread::ruleGenSize);
-            }
-            ruleGenTab[k]->readGenomeBitString(ruleBitString.data(), ComputeThread::ruleGenSize);
+            ruleGenTab[k]->readGenomeBitString(genotypeDataY, k*ruleSize, ruleSize);
+        }
+
+        // Default rules transcription
+        int defRulesPos = fSystem->getRuleBitStringSize()*ComputeThread::nbRules;
+        for (int i = 0; i < defRulesSize; i++) {
+            defRules[i] = genotypeDataY->at(defRulesPos+i);
         }
-    }
-    // Default rules transcription
-    int defRulesSize = fSystem->getDefaultRulesBitStringSize();
-    int defRulesPos = fSystem->getRuleBitStringSize()*ComputeThread::nbRules;
-    QVector<int> defRules(defRulesSize);
-    for (int i = 0; i < defRulesSize; i++) {
-        defRules[i] = genotypeDataY->at(defRulesPos+i);
     }
 
     // Reset the previous fuzzy system
@@ -246,15 +387,8 @@ void CoEvolution::calcFitness(PopEntity *inX, PopEntity *inY)
     fSystem->loadRulesGenome(ruleGenTab.data(), defRules.data());
     // Get the textual systemDescription
     fitness = fSystem->evaluateFitness();
+    if (counted)
+        ComputeThread::countEvaluation(currentGeneration);
 
-    ComputeThread::saveFuzzyAndFitness(fSystem,fitness);
-
-    // Delete everything we don't need anymore ( Created in this functio ).
-    delete membGen;
-    for (int i = 0; i < ComputeThread::nbRules; i++) {
-        delete ruleGenTab[i];
-    }
-
-
-
+    ComputeThread::saveFuzzyAndFitness(fSystem,fitness,genotypeDataX,genotypeDataY);
 }
@@ -39,6 +39,7 @@
 
 #include "../fuzzy/fuzzysystem.h"
 #include "../EvolutionEngine/evolutionengine.h"
+#include "rulealigned.h"
 #include "../Population/population.h"
 #include "../Population/Individual/popentity.h"
 #include "../fuzzy/fuzzymembershipsgenome.h"
@@ -58,12 +59,15 @@ class CoEvolution : public QThread, public EvolutionEngine {
 
     Q_OBJECT
 public:
-    CoEvolution(FuzzySystem *fSystem, QMutex *access, QSemaphore *standby, Population* left, Population* right, quint32 generationCount, qreal crossoverProbability, qreal mutationProbability, qreal mutationPerBitProbability, quint32 eliteSize, quint32 cooperatorsCount, QObject *parent = 0);
+    CoEvolution(FuzzySystem *fSystem, Population* left, Population* right, quint32 generationCount, qreal crossoverProbability, qreal mutationProbability, qreal mutationPerBitProbability, quint32 eliteSize, quint32 cooperatorsCount, QObject *parent = 0);
 
     ~CoEvolution();
 
     void run();
     bool evaluatePopulation(Population* population, quint32 generation);
+    qreal evaluateEntity(const BitString *genotypeData, quint32 generation);
+    bool endGeneration(Population* population, quint32 generation);
+    bool evaluateBestSystem();
     void onSaveSystem(QString fileName);
 
 signals :
@@ -72,13 +76,12 @@ signals :
 
 protected:
     static SystemParameters *sysParams;
-    void calcFitness(PopEntity *inInd1, PopEntity *inInd2);
+    void calcFitness(const BitString *genotypeDataX, const BitString *genotypeDataY, bool counted = true);
+    qreal evaluateCooperation(const BitString *genotypeData, const RepresentativeSet *representatives);
     float fixedToFloat(quint32 fixedInt, int pointPos) const;
 
 private:
     FuzzySystem *fSystem;
-    QMutex *access;
-    QSemaphore *standby;
     Population *left;
     Population *right;
     quint32 generationCount;
@@ -86,6 +89,21 @@ private:
     quint32 eliteSize;
     quint32 cooperatorsCount;
     qreal fitness;
+    FuzzyMembershipsGenome *membGen;
+    QVector<FuzzyRuleGenome *> ruleGenTab;
+    // Codings of the genotypes of the two populations
+    bool membershipsIntegerCoded;
+    bool rulesIntegerCoded;
+    // Best fitness of the population when it last improved by more than the plateau
+    // epsilon, its generation, and whether the population is counted on a plateau
+    qreal plateauFitness;
+    quint32 plateauGeneration;
+    bool onPlateau;
+    // Representatives the children of the current steady state generation are evaluated with in lockstep
+    shared_ptr<const RepresentativeSet> entityRepresentatives;
+    quint32 entityGeneration;
+    // Generation the evaluations are counted for in the budget
+    quint32 currentGeneration;
 
     QString fileName;
     qreal finalFit;
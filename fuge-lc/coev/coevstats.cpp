@@ -35,6 +35,10 @@ CoevStats::CoevStats() : QObject()
     fitMinPop1 = -1.0;
     fitAvgPop1 = -1.0;
     fitStdPop1 = -1.0;
+    entropyPop1 = 0.0;
+    distancePop1 = 0.0;
+    entropyPop2 = 0.0;
+    distancePop2 = 0.0;
     sensi = 0.0;
     speci = 0.0;
     accu = 0.0;
@@ -51,6 +55,8 @@ CoevStats::CoevStats() : QObject()
     sizePop1 = 0;
     sizePop2 = 0;
     genNumber = 0;
+    islandNumber = 0;
+    islandFitMax.fill(-1.0, 1);
 }
 
 CoevStats::~CoevStats()
@@ -28,6 +28,7 @@
 #define COEVSTATS_H
 
 #include <QObject>
+#include <QVector>
 
 class CoevStats : public QObject
 {
@@ -47,6 +48,11 @@ private:
     double fitMinPop2;
     double fitAvgPop2;
     double fitStdPop2;
+    // Diversity : mean entropy of the bits and mean distance between two genotypes
+    double entropyPop1;
+    double distancePop1;
+    double entropyPop2;
+    double distancePop2;
     float sensi;
     float speci;
     float accu;
@@ -69,6 +75,10 @@ private:
     unsigned int genNumber;
     QString bestSystemDescription;
 
+    // Island of the last statistics, and best fitness reached by each island
+    unsigned int islandNumber;
+    QVector<double> islandFitMax;
+
 public:
     static CoevStats& getInstance()
     {
@@ -84,6 +94,10 @@ public:
     inline void setFitMinPop2(double value) {fitMinPop2 = value;}
     inline void setFitAvgPop2(double value) {fitAvgPop2 = value;}
     inline void setFitStdPop2(double value) {fitStdPop2 = value;}
+    inline void setEntropyPop1(double value) {entropyPop1 = value;}
+    inline void setDistancePop1(double value) {distancePop1 = value;}
+    inline void setEntropyPop2(double value) {entropyPop2 = value;}
+    inline void setDistancePop2(double value) {distancePop2 = value;}
     inline void setSensi(float value) {sensi = value;}
     inline void setSpeci(float value) {speci = value;}
     inline void setAccu(float value) {accu = value;}
@@ -102,6 +116,9 @@ public:
     inline void setSizePop2(unsigned int value) {sizePop2 = value;}
     inline void setBestSysDesc(QString desc) {bestSystemDescription = desc;}
     inline void setGenNumber(unsigned int value) {genNumber = value;}
+    inline void setIslandNumber(unsigned int value) {islandNumber = value;}
+    inline void setIslandFitMax(int island, double value) {islandFitMax[island] = value;}
+    inline void resetIslands(int count) {islandFitMax.fill(-1.0, count);}
 
     inline double getFitMaxPop1() {return fitMaxPop1;}
     inline double getFitMinPop1() {return fitMinPop1;}
@@ -111,6 +128,10 @@ public:
     inline double getFitMinPop2() {return fitMinPop2;}
     inline double getFitStdPop2() {return fitStdPop2;}
     inline double getFitAvgPop2() {return fitAvgPop2;}
+    inline double getEntropyPop1() {return entropyPop1;}
+    inline double getDistancePop1() {return distancePop1;}
+    inline double getEntropyPop2() {return entropyPop2;}
+    inline double getDistancePop2() {return distancePop2;}
     inline float getSensi() {return sensi;}
     inline float getSpeci() {return speci;}
     inline float getAccu() {return accu;}
@@ -130,6 +151,9 @@ public:
     inline double getSizePop2() {return sizePop2;}
     inline QString* getBestSysDesc(void) {return &bestSystemDescription;}
     inline unsigned int getGenNumber() {return genNumber;}
+    inline unsigned int getIslandNumber() {return islandNumber;}
+    inline double getIslandFitMax(int island) {return islandFitMax.at(island);}
+    inline int getIslandCount() {return islandFitMax.size();}
 
     void transmitData(QString name);
 
@@ -0,0 +1,264 @@
+/**
+  * @file   runstate.cpp
+  * @author ReDS (Reconfigurable and embedded digital systems) <www.reds.ch>
+  * @author HEIG-VD (Haute école d'ingénierie et de gestion) <www.heig-vd.ch>
+  * @date   10.2026
+  * @section LICENSE
+  *
+  * This application is free software; you can redistribute it and/or
+  * modify it under the terms of the GNU Lesser General Public
+  * License as published by the Free Software Foundation; either
+  * version 2.1 of the License, or (at your option) any later version.
+  *
+  * This library is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  * Lesser General Public License for more details.
+  *
+  * You should have received a copy of the GNU Lesser General Public
+  * License along with this library; if not, write to the Free Software
+  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+  *
+  *
+  * @class RunState
+  *
+  * @brief This class holds the final state of a coevolution run.
+  */
+
+#include <iostream>
+
+#include <QFile>
+#include <QSaveFile>
+#include <QDomDocument>
+
+#include "runstate.h"
+#include "population.h"
+#include "fuzzysystem.h"
+
+/**
+  * Constructor.
+  */
+RunState::RunState()
+{
+    nbSamples = 0;
+}
+
+/**
+  * Read a run state file.
+  *
+  * @param fileName Name of the run state file.
+  * @return false if the file cannot be read.
+  */
+bool RunState::load(const QString& fileName)
+{
+    QString errorMsg;
+    int errorLine, errorColumn;
+
+    QDomDocument doc("Run_State");
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+    if (!doc.setContent(&file, false, &errorMsg, &errorLine, &errorColumn)) {
+        std::cout << "Error : " << fileName.toStdString() << " : " << errorMsg.toStdString() << " "
+                  << errorLine << " " << errorColumn << std::endl;
+        file.close();
+        return false;
+    }
+    file.close();
+
+    populations.clear();
+    varNames.clear();
+    valMins.clear();
+    valMaxs.clear();
+    nbSamples = doc.documentElement().namedItem("Nb_Samples").toElement().text().toInt();
+
+    // Universes of discourse
+    QDomNodeList nodesUniverses = doc.documentElement().namedItem("Universes").toElement().elementsByTagName("Universe");
+    for (int i = 0; i < nodesUniverses.size(); i++) {
+        QDomElement universe = nodesUniverses.at(i).toElement();
+        varNames.append(universe.namedItem("Var_name").toElement().text());
+        valMins.append(universe.namedItem("Min").toElement().text().toFloat());
+        valMaxs.append(universe.namedItem("Max").toElement().text().toFloat());
+    }
+
+    // Populations
+    QDomNodeList nodesPopulations = doc.documentElement().namedItem("Populations").toElement().elementsByTagName("Population");
+    for (int i = 0; i < nodesPopulations.size(); i++) {
+        QDomElement population = nodesPopulations.at(i).toElement();
+        PopulationState state;
+        state.name = population.namedItem("Name").toElement().text();
+        state.genotypeSize = population.namedItem("Genotype_size").toElement().text().toInt();
+        QDomNodeList nodesEntities = population.elementsByTagName("Entity");
+        for (int k = 0; k < nodesEntities.size(); k++) {
+            QDomElement entity = nodesEntities.at(k).toElement();
+            state.genotypes.append(entity.namedItem("Genotype").toElement().text());
+            state.fitnesses.append(entity.namedItem("Fitness").toElement().text().toDouble());
+        }
+        populations.append(state);
+    }
+
+    return true;
+}
+
+/**
+  * Write the run state file, atomically so that an interrupted write does not
+  * destroy the previous state.
+  *
+  * @param fileName Name of the run state file.
+  * @return false if the file cannot be written.
+  */
+bool RunState::save(const QString& fileName) const
+{
+    QDomDocument doc("Run_State");
+    QDomElement root = doc.createElement("Run_State");
+    doc.appendChild(root);
+
+    QDomElement samples = doc.createElement("Nb_Samples");
+    root.appendChild(samples);
+    samples.appendChild(doc.createTextNode(QString::number(nbSamples)));
+
+    QDomElement universes = doc.createElement("Universes");
+    root.appendChild(universes);
+    for (int i = 0; i < varNames.size(); i++) {
+        QDomElement universe = doc.createElement("Universe");
+        universes.appendChild(universe);
+        QDomElement name = doc.createElement("Var_name");
+        universe.appendChild(name);
+        name.appendChild(doc.createTextNode(varNames.at(i)));
+        QDomElement valMin = doc.createElement("Min");
+        universe.appendChild(valMin);
+        valMin.appendChild(doc.createTextNode(QString::number(valMins.at(i), 'g', 9)));
+        QDomElement valMax = doc.createElement("Max");
+        universe.appendChild(valMax);
+        valMax.appendChild(doc.createTextNode(QString::number(valMaxs.at(i), 'g', 9)));
+    }
+
+    QDomElement pops = doc.createElement("Populations");
+    root.appendChild(pops);
+    for (int i = 0; i < populations.size(); i++) {
+        const PopulationState& state = populations.at(i);
+        QDomElement population = doc.createElement("Population");
+        pops.appendChild(population);
+        QDomElement name = doc.createElement("Name");
+        population.appendChild(name);
+        name.appendChild(doc.createTextNode(state.name));
+        QDomElement size = doc.createElement("Genotype_size");
+        population.appendChild(size);
+        size.appendChild(doc.createTextNode(QString::number(state.genotypeSize)));
+        for (int k = 0; k < state.genotypes.size(); k++) {
+            QDomElement entity = doc.createElement("Entity");
+            population.appendChild(entity);
+            QDomElement fitness = doc.createElement("Fitness");
+            entity.appendChild(fitness);
+            fitness.appendChild(doc.createTextNode(QString::number(state.fitnesses.at(k), 'g', 17)));
+            QDomElement genotype = doc.createElement("Genotype");
+            entity.appendChild(genotype);
+            genotype.appendChild(doc.createTextNode(state.genotypes.at(k)));
+        }
+    }
+
+    QSaveFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text) || file.write(doc.toByteArray()) < 0 || !file.commit()) {
+        std::cout << "Error : cannot write the run state " << fileName.toStdString() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+  * Store the individuals of a population, replacing a previous population with
+  * the same name.
+  *
+  * @param population Population to be stored.
+  */
+void RunState::capturePopulation(Population* population)
+{
+    PopulationState state;
+    state.name = population->getName();
+    state.genotypeSize = 0;
+    for (quint32 i = 0; i < population->getSize(); i++) {
+        const BitString* data = population->genotypeAt(i);
+        state.genotypeSize = data->size();
+        state.genotypes.append(data->toString());
+        state.fitnesses.append(population->getFitnessAt(i));
+    }
+
+    for (int i = 0; i < populations.size(); i++) {
+        if (populations.at(i).name == state.name) {
+            populations[i] = state;
+            return;
+        }
+    }
+    populations.append(state);
+}
+
+/**
+  * Store the universes of discourse of the variables of a fuzzy system.
+  *
+  * @param fSystem Fuzzy system the universes are read from.
+  * @param nbSamples Number of samples the run has been made on.
+  */
+void RunState::captureUniverses(FuzzySystem* fSystem, int nbSamples)
+{
+    this->nbSamples = nbSamples;
+    varNames.clear();
+    valMins.clear();
+    valMaxs.clear();
+    for (int i = 0; i < fSystem->getNbInVars() + fSystem->getNbOutVars(); i++) {
+        varNames.append(fSystem->getVar(i)->getName());
+        valMins.append(fSystem->getVarValMin(i));
+        valMaxs.append(fSystem->getVarValMax(i));
+    }
+}
+
+/**
+  * Replace the individuals of a population by the stored ones. The stored
+  * fitnesses are kept until the individuals are evaluated again.
+  *
+  * @param population Population to be restored.
+  * @return false if the population has not been stored with the same size and
+  *         the same genotypes size.
+  */
+bool RunState::restorePopulation(Population* population) const
+{
+    for (int i = 0; i < populations.size(); i++) {
+        const PopulationState& state = populations.at(i);
+        if (state.name != population->getName())
+            continue;
+        if (state.genotypes.size() != (int) population->getSize())
+            return false;
+        for (int k = 0; k < state.genotypes.size(); k++) {
+            if (state.genotypes.at(k).size() != (int) population->getIndividualsLength())
+                return false;
+        }
+
+        for (quint32 k = 0; k < population->getSize(); k++) {
+            BitString* data = population->genotypeAt(k);
+            const QString& genotype = state.genotypes.at(k);
+            for (int j = 0; j < genotype.size(); j++) {
+                data->setBit(j, genotype.at(j) == QChar('1'));
+            }
+            population->setFitnessAt(k, state.fitnesses.at(k));
+        }
+        return true;
+    }
+    return false;
+}
+
+/**
+  * Set the stored universes of discourse to a fuzzy system.
+  *
+  * @param fSystem Fuzzy system receiving the universes.
+  * @return false if the variables of the fuzzy system are not the stored ones.
+  */
+bool RunState::restoreUniverses(FuzzySystem* fSystem) const
+{
+    if (varNames.size() != fSystem->getNbInVars() + fSystem->getNbOutVars())
+        return false;
+    for (int i = 0; i < varNames.size(); i++) {
+        if (fSystem->getVar(i)->getName() != varNames.at(i))
+            return false;
+    }
+    fSystem->setVarUniverses(valMins, valMaxs);
+    return true;
+}
@@ -0,0 +1,78 @@
+/**
+  * @file   runstate.h
+  * @author ReDS (Reconfigurable and embedded digital systems) <www.reds.ch>
+  * @author HEIG-VD (Haute école d'ingénierie et de gestion) <www.heig-vd.ch>
+  * @date   10.2026
+  * @section LICENSE
+  *
+  * This application is free software; you can redistribute it and/or
+  * modify it under the terms of the GNU Lesser General Public
+  * License as published by the Free Software Foundation; either
+  * version 2.1 of the License, or (at your option) any later version.
+  *
+  * This library is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  * Lesser General Public License for more details.
+  *
+  * You should have received a copy of the GNU Lesser General Public
+  * License along with this library; if not, write to the Free Software
+  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+  *
+  * @class RunState
+  *
+  * @brief This class holds the final state of a coevolution run (populations and
+  * universes of discourse) so that a later run can resume from it.
+  *
+  * @section DESCRIPTION
+  *
+  * When samples are appended to the dataset, a new run can start from the final
+  * populations of the previous one instead of random populations. The universes of
+  * discourse of the previous run are kept as well, otherwise the same genomes would
+  * be decoded into different sets positions. The carried-over individuals are scored
+  * again on the whole dataset by the first evaluation of the evolution.
+  *
+  * The state is stored in an XML file, like the fuzzy systems.
+  */
+
+#ifndef RUNSTATE_H
+#define RUNSTATE_H
+
+#include <QString>
+#include <QStringList>
+#include <QList>
+#include <QVector>
+
+class Population;
+class FuzzySystem;
+
+class RunState
+{
+public:
+    RunState();
+
+    bool load(const QString& fileName);
+    bool save(const QString& fileName) const;
+
+    void capturePopulation(Population* population);
+    void captureUniverses(FuzzySystem* fSystem, int nbSamples);
+    bool restorePopulation(Population* population) const;
+    bool restoreUniverses(FuzzySystem* fSystem) const;
+    int getNbSamples() const {return nbSamples;}
+
+private:
+    struct PopulationState {
+        QString name;
+        int genotypeSize;
+        QStringList genotypes;
+        QVector<double> fitnesses;
+    };
+
+    QList<PopulationState> populations;
+    QStringList varNames;
+    QVector<float> valMins;
+    QVector<float> valMaxs;
+    int nbSamples;
+};
+
+#endif // RUNSTATE_H
@@ -27,6 +27,8 @@
   */
 
 #include "computethread.h"
+#include "runstate.h"
+#include <limits>
 int ComputeThread::nbRules = 0;
 int ComputeThread::membersGenSize = 0;
 int ComputeThread::ruleGenSize = 0;
@@ -36,11 +38,21 @@ int ComputeThread::nbOutVars = 0;
 int ComputeThread::outSetsCodeSize = 0;
 FuzzySystem* ComputeThread::bestFSystem = 0;
 qreal ComputeThread::bestFitness = 0.0;
+BitString ComputeThread::bestMemberships;
+BitString ComputeThread::bestRules;
 QString ComputeThread::bestFuzzySystemDescription = "";
 SystemParameters *ComputeThread::sysParams = NULL;
 QMutex ComputeThread::mutex;
 QMutex ComputeThread::mutex2;
 bool ComputeThread::stop = false;
+QString ComputeThread::stopReason;
+int ComputeThread::stopGeneration = 0;
+std::atomic<int> ComputeThread::plateauCount(0);
+int ComputeThread::populationCount = 0;
+std::atomic<quint64> ComputeThread::evaluationCount(0);
+quint64 ComputeThread::evaluationLimit = 0;
+qint64 ComputeThread::timeLimit = 0;
+qint64 ComputeThread::nextCheckpoint = 0;
 
 ComputeThread::ComputeThread()
 {
@@ -73,6 +85,8 @@ void ComputeThread::run()
     startTime = QTime::currentTime();
 
     ComputeThread::stop = false;
+    ComputeThread::stopReason.clear();
+    ComputeThread::stopGeneration = 0;
     ComputeThread::bestFitness = 0.0;
     ComputeThread::bestFSystem = 0;
     ComputeThread::bestFuzzySystemDescription.clear();
@@ -105,47 +119,176 @@ void ComputeThread::run()
         vars.genotypeSize = fSystemLeft->getMembershipsBitStringSize();
         rules.genotypeSize = ((fSystemLeft->getRuleBitStringSize())*fSystemLeft->getNbRules())+fSystemLeft->getDefaultRulesBitStringSize();
 
-        Population *popVar = new Population("MEMBERSHIPS", sysParams->getPopSizePop1(), vars.genotypeSize);
-        Population *popRules = new Population("RULES", sysParams->getPopSizePop2(), rules.genotypeSize);
-
-        QMutex *access = new QMutex();
-        QSemaphore *standby = new QSemaphore(0);
+        // Stream 0 of the run creates the populations, each evolution has its own stream
+        static quint32 runCount = 0;
+        const quint32 runNumber = runCount++;
+        std::cout << "[Seed] : " << sysParams->getSeed() << " (run " << runNumber << ")" << std::endl;
+        RandomGenerator runGenerator(sysParams->getSeed(), runNumber, 0);
+
+        // The budgets left are shared equally between this run and the next ones
+        const int runsLeft = qMax(1, sysParams->getPlannedRuns() - sysParams->getStartedRuns());
+        sysParams->setStartedRuns(sysParams->getStartedRuns() + 1);
+        const qint64 runStart = sysParams->getElapsedTime();
+        ComputeThread::timeLimit = -1;
+        ComputeThread::evaluationLimit = std::numeric_limits<quint64>::max();
+        if (sysParams->getTimeBudget() > 0) {
+            ComputeThread::timeLimit = runStart + qMax<qint64>(0, sysParams->getTimeBudget() - runStart) / runsLeft;
+            std::cout << "[TimeBudget] : " << ComputeThread::timeLimit - runStart << " ms (run " << runNumber << ")" << std::endl;
+        }
+        if (sysParams->getEvaluationBudget() > 0) {
+            const quint64 evaluations = ComputeThread::evaluationCount;
+            const quint64 evaluationsLeft = sysParams->getEvaluationBudget() > evaluations ?
+                        sysParams->getEvaluationBudget() - evaluations : 0;
+            ComputeThread::evaluationLimit = evaluations + evaluationsLeft / runsLeft;
+            std::cout << "[EvaluationBudget] : " << evaluationsLeft / runsLeft << " (run " << runNumber << ")" << std::endl;
+        }
+        ComputeThread::nextCheckpoint = runStart + sysParams->getSaveInterval();
+        RandomGenerator::setThreadGenerator(&runGenerator);
+
+        // The positions of the sets must fit in a gene
+        if (sysParams->getIntegerCodedPop1() &&
+                qMax(fSystemLeft->getInSetsPosCodeSize(), fSystemLeft->getOutSetsPosCodeSize()) > BitString::GENE_BITS) {
+            std::cout << "Error : the sets positions are coded on more than " << BitString::GENE_BITS
+                      << " bits, the memberships genotypes are bit strings" << std::endl;
+            sysParams->setIntegerCodedPop1(false);
+        }
 
-        leftEvolution = new CoEvolution(fSystemLeft, access, standby, popVar, popRules, sysParams->getMaxGenPop1(),  sysParams->getCxProbPop1(),sysParams->getMutFlipIndPop1(), sysParams->getMutFlipBitPop1(),sysParams->getEliteSizePop1(), sysParams->getNbCooperators());
-        rightEvolution = new CoEvolution(fSystemRight, access, standby, popRules, popVar, sysParams->getMaxGenPop1(), sysParams->getCxProbPop2(), sysParams->getMutFlipIndPop2(), sysParams->getMutFlipBitPop2(),sysParams->getEliteSizePop1(), sysParams->getNbCooperators());
+        Population *popVar = sysParams->getIntegerCodedPop1() ?
+                    new Population("MEMBERSHIPS", sysParams->getPopSizePop1(), fSystemLeft->getMembershipsGeneRanges()) :
+                    new Population("MEMBERSHIPS", sysParams->getPopSizePop1(), vars.genotypeSize);
+        Population *popRules = sysParams->getIntegerCodedPop2() ?
+                    new Population("RULES", sysParams->getPopSizePop2(), fSystemLeft->getRulesGeneRanges()) :
+                    new Population("RULES", sysParams->getPopSizePop2(), rules.genotypeSize);
+        vars.genotypeSize = popVar->getIndividualsLength();
+        rules.genotypeSize = popRules->getIndividualsLength();
+
+        // Resume from the final state of a previous run, on the dataset with the appended samples
+        const QString runStateFile = sysParams->getRunStateFile();
+        quint32 generationCount = sysParams->getMaxGenPop1();
+        RunState runState;
+        if (!runStateFile.isEmpty() && QFileInfo(runStateFile).exists() && runState.load(runStateFile)) {
+            if (runState.restorePopulation(popVar) && runState.restorePopulation(popRules) &&
+                    runState.restoreUniverses(fSystemLeft) && runState.restoreUniverses(fSystemRight)) {
+                generationCount = sysParams->getResumeGenerations();
+                if (generationCount == 0)
+                    generationCount = qMax(1, sysParams->getMaxGenPop1() / 4);
+                std::cout << "[ResumedSamples] : " << runState.getNbSamples() << " / " << fSystemLeft->getNbSamples() << std::endl;
+            }
+            else {
+                std::cout << "Error : the run state " << runStateFile.toStdString()
+                          << " does not match the parameters or the dataset, the evolution starts from random populations" << std::endl;
+                popVar->randomizePopulation();
+                popRules->randomizePopulation();
+            }
+        }
 
-        connect(leftEvolution,SIGNAL(fitnessThreshReached()), this, SLOT(onStopEvo()));
-        connect(rightEvolution,SIGNAL(fitnessThreshReached()), this, SLOT(onStopEvo()));
+        // The other islands start from random populations, with the same universes
+        const int islandCount = qMax(1, sysParams->getIslandCount());
+        QVector<Population *> varPopulations;
+        QVector<Population *> rulesPopulations;
+        QVector<FuzzySystem *> islandSystems;
+        varPopulations.append(popVar);
+        rulesPopulations.append(popRules);
+        for (int island = 1; island < islandCount; island++) {
+            varPopulations.append(popVar->isIntegerCoded() ?
+                                      new Population("MEMBERSHIPS", popVar->getSize(), popVar->getGeneRanges()) :
+                                      new Population("MEMBERSHIPS", popVar->getSize(), popVar->getIndividualsLength()));
+            rulesPopulations.append(popRules->isIntegerCoded() ?
+                                        new Population("RULES", popRules->getSize(), popRules->getGeneRanges()) :
+                                        new Population("RULES", popRules->getSize(), popRules->getIndividualsLength()));
+            islandSystems.append(createIslandSystem());
+            islandSystems.append(createIslandSystem());
+        }
+        CoevStats::getInstance().resetIslands(islandCount);
+        ComputeThread::plateauCount = 0;
+        ComputeThread::populationCount = 2 * islandCount;
+
+        RandomGenerator::setThreadGenerator(NULL);
+
+        // Each evolution draws from its own stream, the first island keeps the streams of a single pair
+        const bool randomTopology = sysParams->getMigrationTopology().compare("Random", Qt::CaseInsensitive) == 0;
+        for (int island = 0; island < islandCount; island++) {
+            FuzzySystem *fSystemVars = (island == 0) ? fSystemLeft : islandSystems.at(2*island - 2);
+            FuzzySystem *fSystemRules = (island == 0) ? fSystemRight : islandSystems.at(2*island - 1);
+            CoEvolution *leftEvolution = new CoEvolution(fSystemVars, varPopulations.at(island), rulesPopulations.at(island), generationCount, sysParams->getCxProbPop1(),sysParams->getMutFlipIndPop1(), sysParams->getMutFlipBitPop1(),sysParams->getEliteSizePop1(), sysParams->getNbCooperators());
+            CoEvolution *rightEvolution = new CoEvolution(fSystemRules, rulesPopulations.at(island), varPopulations.at(island), generationCount, sysParams->getCxProbPop2(), sysParams->getMutFlipIndPop2(), sysParams->getMutFlipBitPop2(),sysParams->getEliteSizePop1(), sysParams->getNbCooperators());
+
+            leftEvolution->setRandomGenerator(RandomGenerator(sysParams->getSeed(), runNumber, 2*island + 1));
+            rightEvolution->setRandomGenerator(RandomGenerator(sysParams->getSeed(), runNumber, 2*island + 2));
+            // The diversity samplers draw from the streams after those of the evolutions
+            leftEvolution->getStatisticEngine()->setRandomGenerator(RandomGenerator(sysParams->getSeed(), runNumber, 2*islandCount + 2*island + 1));
+            rightEvolution->getStatisticEngine()->setRandomGenerator(RandomGenerator(sysParams->getSeed(), runNumber, 2*islandCount + 2*island + 2));
+            leftEvolution->setMigration(varPopulations, island, sysParams->getMigrationInterval(), sysParams->getMigrationSize(), randomTopology);
+            rightEvolution->setMigration(rulesPopulations, island, sysParams->getMigrationInterval(), sysParams->getMigrationSize(), randomTopology);
+
+            connect(leftEvolution,SIGNAL(fitnessThreshReached()), this, SLOT(onStopEvo()));
+            connect(rightEvolution,SIGNAL(fitnessThreshReached()), this, SLOT(onStopEvo()));
+            leftEvolutions.append(leftEvolution);
+            rightEvolutions.append(rightEvolution);
+        }
 
         qDebug() << "END_GetInstance";
 
         // 3. start evolution
         qDebug() << "Start Evolution";
-        leftEvolution->start();
-        rightEvolution->start();
+        for (int island = 0; island < islandCount; island++) {
+            leftEvolutions.at(island)->start();
+            rightEvolutions.at(island)->start();
+        }
 
         qDebug() << "Start waiting Evolution";
-        rightEvolution->wait();
-        leftEvolution->wait();
+        for (int island = 0; island < islandCount; island++) {
+            rightEvolutions.at(island)->wait();
+            leftEvolutions.at(island)->wait();
+        }
         qDebug() << "End waiting Evolution";
 
+        // The fuzzy systems have since evaluated other couples : the best
+        // couple found is evaluated again, so that bestFSystem is this system.
+        // It is a system of the first island, the others are deleted.
+        if (ComputeThread::bestFSystem != NULL)
+            leftEvolutions.at(0)->evaluateBestSystem();
+
+        if (ComputeThread::stopReason.isEmpty())
+            std::cout << "[StopReason] : MaxGenerations (generation " << generationCount << ")" << std::endl;
+        else
+            std::cout << "[StopReason] : " << ComputeThread::stopReason.toStdString()
+                      << " (generation " << ComputeThread::stopGeneration << ")" << std::endl;
+
+        if (islandCount > 1) {
+            CoevStats& fitStats = CoevStats::getInstance();
+            for (int island = 0; island < islandCount; island++)
+                std::cout << "[IslandFitness] " << island << " : " << fitStats.getIslandFitMax(island) << std::endl;
+        }
+
+        if (!runStateFile.isEmpty()) {
+            runState.capturePopulation(popVar);
+            runState.capturePopulation(popRules);
+            runState.captureUniverses(fSystemLeft, fSystemLeft->getNbSamples());
+            runState.save(runStateFile);
+        }
+
 //        if(bestFSystem != fSystemLeft && fSystemLeft != 0)
 //            delete fSystemLeft;
 //        else if(bestFSystem != fSystemRight && fSystemRight != 0)
 //            delete fSystemRight;
 
-        delete access;
-        delete standby;
-        delete popVar;
-        delete popRules;
-        delete leftEvolution;
-        delete rightEvolution;
+        qDeleteAll(leftEvolutions);
+        qDeleteAll(rightEvolutions);
+        leftEvolutions.clear();
+        rightEvolutions.clear();
+        qDeleteAll(varPopulations);
+        qDeleteAll(rulesPopulations);
+        qDeleteAll(islandSystems);
 
     }
 
     catch(std::exception& inException) {
         std::cerr << "Standard exception catched:" << std::endl << std::flush;
         std::cerr << inException.what() << std::endl << std::flush;
+        RandomGenerator::setThreadGenerator(NULL);
+        leftEvolutions.clear();
+        rightEvolutions.clear();
     }
 
     // End Timer
@@ -156,6 +299,30 @@ void ComputeThread::run()
     emit computeFinished();
 }
 
+/**
+  * Create a fuzzy system for the populations of another island, like the
+  * systems given to the thread, on the same data and universes.
+  */
+FuzzySystem *ComputeThread::createIslandSystem()
+{
+    FuzzySystem *fSystem = new FuzzySystem();
+    fSystem->setParameters(fSystemLeft->getNbRules(), fSystemLeft->getNbVarPerRule(), fSystemLeft->getNbOutVars(),
+                           fSystemLeft->getNbInSets(), fSystemLeft->getNbOutSets(), fSystemLeft->getInVarsCodeSize(),
+                           fSystemLeft->getOutVarsCodeSize(), fSystemLeft->getInSetsCodeSize(), fSystemLeft->getOutSetsCodeSize(),
+                           fSystemLeft->getInSetsPosCodeSize(), fSystemLeft->getOutSetsPosCodeSize());
+    fSystem->loadData(fSystemLeft->getDataset());
+    fSystem->setFixedPoint(fSystemLeft->isFixedPoint());
+
+    QVector<float> valMins;
+    QVector<float> valMaxs;
+    for (int i = 0; i < fSystemLeft->getNbInVars() + fSystemLeft->getNbOutVars(); i++) {
+        valMins.append(fSystemLeft->getVarValMin(i));
+        valMaxs.append(fSystemLeft->getVarValMax(i));
+    }
+    fSystem->setVarUniverses(valMins, valMaxs);
+    return fSystem;
+}
+
 /**
   * Slot called when a request to save the system is performed
   */
@@ -224,11 +391,108 @@ void ComputeThread::onStopEvo()
     ComputeThread::stop = true;
 }
 
-void ComputeThread::saveFuzzyAndFitness(FuzzySystem *fSystem, qreal fitness){
+/**
+  * Return the fitness of the best fuzzy system found during the run.
+  */
+qreal ComputeThread::getBestFitness(){
+    QMutexLocker locker(&mutex2);
+    return ComputeThread::bestFitness;
+}
+
+/**
+  * Copy the couple of genotypes of the best fuzzy system found during the run.
+  *
+  * @return false if no fuzzy system has been evaluated yet.
+  */
+bool ComputeThread::getBestGenotypes(BitString &memberships, BitString &rules){
+    QMutexLocker locker(&mutex2);
+    if (ComputeThread::bestFSystem == NULL)
+        return false;
+    memberships = ComputeThread::bestMemberships;
+    rules = ComputeThread::bestRules;
+    return true;
+}
+
+/**
+  * Stop the evolutions of the run, recording the reason of the first stop
+  * requested and its generation.
+  */
+void ComputeThread::requestStop(QString reason, int generation){
+    QMutexLocker locker(&mutex);
+    if (ComputeThread::stopReason.isEmpty()) {
+        ComputeThread::stopReason = reason;
+        ComputeThread::stopGeneration = generation;
+    }
+    ComputeThread::stop = true;
+}
+
+/**
+  * Count the populations on a plateau, a population reaching one or leaving
+  * it, and stop the run once all its populations are on a plateau.
+  */
+void ComputeThread::reportPlateau(bool reached, int generation){
+    if (!reached) {
+        ComputeThread::plateauCount--;
+        return;
+    }
+    if (++ComputeThread::plateauCount >= ComputeThread::populationCount)
+        requestStop("Plateau", generation);
+}
+
+/**
+  * Count an evaluation of a fuzzy system, and stop the run once its share of
+  * the time or evaluations budget is spent.
+  */
+void ComputeThread::countEvaluation(int generation){
+    const quint64 evaluations = ++ComputeThread::evaluationCount;
+    if (ComputeThread::stop)
+        return;
+    if (evaluations >= ComputeThread::evaluationLimit)
+        requestStop("EvaluationBudget", generation);
+    else if (ComputeThread::timeLimit >= 0 && sysParams->getElapsedTime() >= ComputeThread::timeLimit)
+        requestStop("TimeBudget", generation);
+}
+
+/**
+  * Check whether a save of the best system so far is due. Only the first
+  * caller gets true, and must save it, the next save is then scheduled.
+  */
+bool ComputeThread::claimCheckpoint(){
+    if (sysParams->getSaveInterval() <= 0)
+        return false;
+    QMutexLocker locker(&mutex);
+    const qint64 now = sysParams->getElapsedTime();
+    if (now < ComputeThread::nextCheckpoint)
+        return false;
+    ComputeThread::nextCheckpoint = now + sysParams->getSaveInterval();
+    return true;
+}
+
+/**
+  * Return the file receiving the best fuzzy system of the run, in the temp
+  * directory of the save path, which is created if needed.
+  */
+QString ComputeThread::currentBestFileName(){
+    SystemParameters& sysParams = SystemParameters::getInstance();
+    QDir tempDir;
+    if (!tempDir.exists(sysParams.getSavePath()+"temp")) {
+        tempDir.mkdir(sysParams.getSavePath()+"temp");
+    }
+    return QString(sysParams.getSavePath()+"temp/currentBest_") +
+            QString::number(QCoreApplication::applicationPid()) + QString(".ffs");
+}
+
+/**
+  * Keep the fuzzy system if it is the best one found, with the couple of
+  * genotypes it has been built from.
+  */
+void ComputeThread::saveFuzzyAndFitness(FuzzySystem *fSystem, qreal fitness, const BitString *memberships, const BitString *rules){
     QMutexLocker locker(&mutex2);
     if(fitness >= ComputeThread::bestFitness){
         ComputeThread::bestFitness = fitness;
         ComputeThread::bestFSystem = fSystem;
+        ComputeThread::bestMemberships = *memberships;
+        ComputeThread::bestRules = *rules;
         ComputeThread::bestFuzzySystemDescription.clear();
         ComputeThread::bestFuzzySystemDescription.append(ComputeThread::bestFSystem->getSystemDescritpion());
 
@@ -262,7 +526,7 @@ void ComputeThread::saveFuzzyAndFitness(FuzzySystem *fSystem, qreal fitness){
     }
 }
 
-void ComputeThread::saveSystemStats(QString name, qreal minFitness, qreal maxFitness, qreal meanFitness, qreal standardDeviation, int populationSize, int generation){
+void ComputeThread::saveSystemStats(QString name, qreal minFitness, qreal maxFitness, qreal meanFitness, qreal standardDeviation, qreal bitEntropy, qreal pairDistance, int populationSize, int generation, int island){
     QMutexLocker locker(&mutex);
     //TODO CHANGE THE VALUES AND ADD CORRECT PARAMS
     CoevStats& fitStats = CoevStats::getInstance();
@@ -272,6 +536,8 @@ void ComputeThread::saveSystemStats(QString name, qreal minFitness, qreal maxFit
         fitStats.setFitAvgPop2(meanFitness);
         fitStats.setFitMinPop2(minFitness);
         fitStats.setFitStdPop2(standardDeviation);
+        fitStats.setEntropyPop2(bitEntropy);
+        fitStats.setDistancePop2(pairDistance);
         fitStats.setSizePop2(populationSize);
 
     }else{
@@ -279,9 +545,14 @@ void ComputeThread::saveSystemStats(QString name, qreal minFitness, qreal maxFit
         fitStats.setFitAvgPop1(meanFitness);
         fitStats.setFitMinPop1(minFitness);
         fitStats.setFitStdPop1(standardDeviation);
+        fitStats.setEntropyPop1(bitEntropy);
+        fitStats.setDistancePop1(pairDistance);
         fitStats.setSizePop1(populationSize);
     }
     fitStats.setGenNumber(generation);
+    fitStats.setIslandNumber(island);
+    if (island < fitStats.getIslandCount() && maxFitness > fitStats.getIslandFitMax(island))
+        fitStats.setIslandFitMax(island, maxFitness);
     // Send Data to graph.
     fitStats.transmitData(name);
 
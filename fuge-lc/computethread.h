@@ -39,6 +39,7 @@
 #include <QMutex>
 #include <QTime>
 #include <QSemaphore>
+#include <atomic>
 
 #include "coevolution.h"
 #include "fuzzysystem.h"
@@ -67,10 +68,32 @@ public:
     static FuzzySystem* bestFSystem;
     static QString bestFuzzySystemDescription;
     static qreal bestFitness;
-    static void saveFuzzyAndFitness(FuzzySystem *fSystem, qreal fitness);
-    static void saveSystemStats(QString name, qreal minFitness, qreal maxFitness, qreal meanFitness, qreal standardDeviation, int populationSize, int generation);
+    static BitString bestMemberships;
+    static BitString bestRules;
+    static void saveFuzzyAndFitness(FuzzySystem *fSystem, qreal fitness, const BitString *memberships, const BitString *rules);
+    static void saveSystemStats(QString name, qreal minFitness, qreal maxFitness, qreal meanFitness, qreal standardDeviation, qreal bitEntropy, qreal pairDistance, int populationSize, int generation, int island);
+    static qreal getBestFitness();
+    static bool getBestGenotypes(BitString &memberships, BitString &rules);
+    static void requestStop(QString reason, int generation);
+    static void reportPlateau(bool reached, int generation);
+    static void countEvaluation(int generation);
+    static bool claimCheckpoint();
+    static QString currentBestFileName();
     static SystemParameters *sysParams;
     static bool stop;
+    // Reason and generation of the stop of the run, empty when it has not been stopped
+    static QString stopReason;
+    static int stopGeneration;
+    // Populations on a plateau, and number of populations of the run
+    static std::atomic<int> plateauCount;
+    static int populationCount;
+    // Evaluations of all the runs, and the share of the budgets of this run :
+    // number of evaluations and time (in ms since the start) at which it stops
+    static std::atomic<quint64> evaluationCount;
+    static quint64 evaluationLimit;
+    static qint64 timeLimit;
+    // Time of the next save of the best system so far
+    static qint64 nextCheckpoint;
 protected:
     void run();
     static QMutex mutex;
@@ -80,12 +103,12 @@ private:
     FuzzySystem* fSystemLeft;
     FuzzySystem* fSystemRight;
 
-    QList<QStringList>* listFile;
     int counter;
     bool fuzzySystemLoaded;
 
-    CoEvolution *leftEvolution;
-    CoEvolution *rightEvolution;
+    // Evolutions of the memberships and of the rules populations of each island
+    QVector<CoEvolution *> leftEvolutions;
+    QVector<CoEvolution *> rightEvolutions;
 
     struct POPULATION_CONFIG_TYPE
     {
@@ -98,6 +121,7 @@ private:
     qreal elapsedTime;
 
     void loadConfiguration(POPULATION_CONFIG_TYPE &config, QString fileNameWithDirPath);
+    FuzzySystem *createIslandSystem();
 
 signals:
     void computeFinished();
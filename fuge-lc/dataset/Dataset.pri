@@ -0,0 +1,25 @@
+INCLUDEPATH += $$PWD
+DEPENDPATH += $$PWD
+
+SOURCES += $$PWD/csvblockreader.cpp \
+    $$PWD/csvloader.cpp \
+    $$PWD/dataset.cpp \
+    $$PWD/datasetcache.cpp \
+    $$PWD/decompressdevice.cpp
+
+HEADERS += $$PWD/csvblockreader.h \
+    $$PWD/csvloader.h \
+    $$PWD/dataset.h \
+    $$PWD/datasetcache.h \
+    $$PWD/decompressdevice.h
+
+# Compressed datasets (.gz, .zst), when the libraries are available
+CONFIG += link_pkgconfig
+packagesExist(zlib) {
+    PKGCONFIG += zlib
+    DEFINES += FUGE_HAVE_ZLIB
+}
+packagesExist(libzstd) {
+    PKGCONFIG += libzstd
+    DEFINES += FUGE_HAVE_ZSTD
+}
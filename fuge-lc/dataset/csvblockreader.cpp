@@ -0,0 +1,138 @@
+/**
+  * @file   csvblockreader.cpp
+  * @author ReDS (Reconfigurable and embedded digital systems) <www.reds.ch>
+  * @author HEIG-VD (Haute école d'ingénierie et de gestion) <www.heig-vd.ch>
+  * @date   10.2026
+  * @section LICENSE
+  *
+  * This application is free software; you can redistribute it and/or
+  * modify it under the terms of the GNU Lesser General Public
+  * License as published by the Free Software Foundation; either
+  * version 2.1 of the License, or (at your option) any later version.
+  *
+  * This library is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  * Lesser General Public License for more details.
+  *
+  * You should have received a copy of the GNU Lesser General Public
+  * License along with this library; if not, write to the Free Software
+  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+  *
+  *
+  * @class CsvBlockReader
+  *
+  * @brief This class reads a ';' separated CSV file sequentially, by blocks of samples.
+  */
+
+#include <iostream>
+
+#include <QFile>
+
+#include "csvblockreader.h"
+#include "csvloader.h"
+
+/**
+  * Constructor.
+  */
+CsvBlockReader::CsvBlockReader() :
+    device(NULL),
+    decompressor(NULL)
+{
+}
+
+/**
+  * Destructor.
+  */
+CsvBlockReader::~CsvBlockReader()
+{
+    delete device;
+}
+
+/**
+  * Open a CSV file and read its header.
+  *
+  * @param fileName Name of the CSV file, possibly compressed (.gz, .zst).
+  * @return false if the file cannot be read.
+  */
+bool CsvBlockReader::open(const QString& fileName)
+{
+    delete device;
+    decompressor = NULL;
+    if (DecompressDevice::formatOf(fileName) != DecompressDevice::Plain) {
+        decompressor = new DecompressDevice(fileName);
+        device = decompressor;
+    }
+    else {
+        device = new QFile(fileName);
+    }
+    if (!device->open(QIODevice::ReadOnly)) {
+        std::cout << "Error : cannot open the dataset " << fileName.toStdString() << std::endl;
+        return false;
+    }
+
+    const QByteArray header = device->readLine();
+    int headerSize = header.size();
+    if (headerSize > 0 && header.at(headerSize - 1) == '\n')
+        headerSize--;
+    columnNames = CsvLoader::parseHeader(header.constData(), header.constData() + headerSize);
+    keptNames = columnNames;
+    fieldColumns.clear();
+
+    return true;
+}
+
+/**
+  * Select the columns of the file read into the blocks. The columns keep the order
+  * they have in the file.
+  *
+  * @param keptColumns One flag per column of the file (see getColumnNames()).
+  */
+void CsvBlockReader::setProjection(const QVector<bool>& keptColumns)
+{
+    keptNames.clear();
+    fieldColumns.fill(-1, columnNames.size());
+    for (int i = 0; i < columnNames.size() && i < keptColumns.size(); i++) {
+        if (keptColumns.at(i)) {
+            fieldColumns[i] = keptNames.size();
+            keptNames.append(columnNames.at(i));
+        }
+    }
+}
+
+/**
+  * Read and parse the next block of samples.
+  *
+  * @param maxSamples Maximal number of samples of the block.
+  * @param dataset Dataset receiving the samples of the block.
+  * @return false if there is no more samples in the file.
+  */
+bool CsvBlockReader::readBlock(int maxSamples, Dataset* dataset)
+{
+    buffer.clear();
+    int nbSamples = 0;
+    while (nbSamples < maxSamples && !device->atEnd()) {
+        const QByteArray line = device->readLine();
+        // Blank lines are skipped by the parser, they do not count
+        if (!(line.isEmpty() || line == "\n" || line == "\r" || line == "\r\n"))
+            nbSamples++;
+        buffer.append(line);
+    }
+
+    if (nbSamples == 0) {
+        dataset->clear();
+        return false;
+    }
+
+    CsvLoader::parseSamples(buffer.constData(), buffer.constData() + buffer.size(), keptNames, dataset, fieldColumns);
+    return true;
+}
+
+/**
+  * Return true if the end of a compressed file could not be read because the file
+  * is corrupted or truncated. The blocks already read are valid.
+  */
+bool CsvBlockReader::isCorrupted() const
+{
+    return decompressor != NULL && decompressor->isCorrupted();
+}
@@ -0,0 +1,67 @@
+/**
+  * @file   csvblockreader.h
+  * @author ReDS (Reconfigurable and embedded digital systems) <www.reds.ch>
+  * @author HEIG-VD (Haute école d'ingénierie et de gestion) <www.heig-vd.ch>
+  * @date   10.2026
+  * @section LICENSE
+  *
+  * This application is free software; you can redistribute it and/or
+  * modify it under the terms of the GNU Lesser General Public
+  * License as published by the Free Software Foundation; either
+  * version 2.1 of the License, or (at your option) any later version.
+  *
+  * This library is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  * Lesser General Public License for more details.
+  *
+  * You should have received a copy of the GNU Lesser General Public
+  * License along with this library; if not, write to the Free Software
+  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+  *
+  *
+  * @class CsvBlockReader
+  *
+  * @brief This class reads a ';' separated CSV file sequentially, by blocks of samples.
+  *
+  * @section DESCRIPTION
+  *
+  * Only one block of lines is held in memory at a time, so files of any size can be
+  * processed with a constant amount of memory. Each block is parsed by CsvLoader into
+  * a Dataset holding the same columns as the file, or only the columns selected by
+  * setProjection(), the other ones being skipped by the parser. Compressed files
+  * (.gz, .zst) are decompressed on the fly by a DecompressDevice.
+  */
+
+#ifndef CSVBLOCKREADER_H
+#define CSVBLOCKREADER_H
+
+#include <QIODevice>
+#include <QByteArray>
+#include <QStringList>
+
+#include "dataset.h"
+#include "decompressdevice.h"
+
+class CsvBlockReader
+{
+public:
+    CsvBlockReader();
+    ~CsvBlockReader();
+
+    bool open(const QString& fileName);
+    void setProjection(const QVector<bool>& keptColumns);
+    bool readBlock(int maxSamples, Dataset* dataset);
+    bool isCorrupted() const;
+    const QStringList& getColumnNames() const {return columnNames;}
+
+private:
+    QIODevice* device;
+    DecompressDevice* decompressor;
+    QStringList columnNames;
+    QStringList keptNames;
+    QVector<int> fieldColumns;
+    QByteArray buffer;
+};
+
+#endif // CSVBLOCKREADER_H
@@ -0,0 +1,296 @@
+/**
+  * @file   csvloader.cpp
+  * @author ReDS (Reconfigurable and embedded digital systems) <www.reds.ch>
+  * @author HEIG-VD (Haute école d'ingénierie et de gestion) <www.heig-vd.ch>
+  * @date   10.2026
+  * @section LICENSE
+  *
+  * This application is free software; you can redistribute it and/or
+  * modify it under the terms of the GNU Lesser General Public
+  * License as published by the Free Software Foundation; either
+  * version 2.1 of the License, or (at your option) any later version.
+  *
+  * This library is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  * Lesser General Public License for more details.
+  *
+  * You should have received a copy of the GNU Lesser General Public
+  * License along with this library; if not, write to the Free Software
+  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+  *
+  *
+  * @class CsvLoader
+  *
+  * @brief This class loads a ';' separated CSV file into a Dataset.
+  */
+
+#include <cstring>
+#include <iostream>
+
+#include <QFile>
+#include <QByteArray>
+#include <QList>
+#include <QThread>
+#include <QtConcurrent>
+#include <QtNumeric>
+
+#include "csvloader.h"
+#include "csvblockreader.h"
+#include "decompressdevice.h"
+
+// Minimal size of a chunk parsed by a thread
+#define MIN_CHUNK_SIZE (1 << 20)
+// Number of samples parsed at once from a compressed file
+#define COMPRESSED_BLOCK_SIZE (1 << 18)
+
+/**
+  * Load a CSV file, possibly compressed (.gz, .zst).
+  *
+  * @param fileName Name of the CSV file.
+  * @param dataset Dataset receiving the values.
+  * @return false if the file cannot be read.
+  */
+bool CsvLoader::load(const QString& fileName, Dataset* dataset)
+{
+    if (DecompressDevice::formatOf(fileName) != DecompressDevice::Plain)
+        return loadCompressed(fileName, dataset);
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        std::cout << "Error : cannot open the dataset " << fileName.toStdString() << std::endl;
+        return false;
+    }
+
+    // Map the file, or read it if it cannot be mapped
+    const qint64 size = file.size();
+    QByteArray buffer;
+    const char* data = (const char*) file.map(0, size);
+    if (data == NULL) {
+        buffer = file.readAll();
+        data = buffer.constData();
+    }
+    const char* end = data + size;
+
+    // Columns names
+    const char* headerEnd = lineEnd(data, end);
+    const QStringList names = parseHeader(data, headerEnd);
+
+    const char* body = (headerEnd < end) ? headerEnd + 1 : end;
+    parseSamples(body, end, names, dataset);
+
+    return true;
+}
+
+/**
+  * Load a compressed CSV file. The file is parsed by blocks of samples while the
+  * decompression thread produces the next ones, then the blocks are gathered into
+  * the dataset.
+  *
+  * @param fileName Name of the compressed CSV file.
+  * @param dataset Dataset receiving the values.
+  * @return false if the file cannot be read.
+  */
+bool CsvLoader::loadCompressed(const QString& fileName, Dataset* dataset)
+{
+    CsvBlockReader reader;
+    if (!reader.open(fileName))
+        return false;
+
+    QList<Dataset*> blocks;
+    int nbSamples = 0;
+    Dataset* block = new Dataset();
+    while (reader.readBlock(COMPRESSED_BLOCK_SIZE, block)) {
+        nbSamples += block->getNbSamples();
+        blocks.append(block);
+        block = new Dataset();
+    }
+    delete block;
+    if (reader.isCorrupted()) {
+        qDeleteAll(blocks);
+        return false;
+    }
+
+    // The missing values are written back as NaN to be flagged again by finalize()
+    dataset->allocate(reader.getColumnNames(), nbSamples);
+    int firstSample = 0;
+    for (int i = 0; i < blocks.size(); i++) {
+        block = blocks.at(i);
+        for (int column = 0; column < dataset->getNbColumns(); column++) {
+            float* values = dataset->columnData(column) + firstSample;
+            for (int k = 0; k < block->getNbSamples(); k++) {
+                values[k] = block->isMissing(column, k) ? qQNaN() : block->getValue(column, k);
+            }
+        }
+        firstSample += block->getNbSamples();
+        delete block;
+    }
+    dataset->finalize();
+
+    return true;
+}
+
+/**
+  * Return the columns names of a header line, without the samples names column.
+  *
+  * @param begin Start of the header line.
+  * @param end End of the header line.
+  */
+QStringList CsvLoader::parseHeader(const char* begin, const char* end)
+{
+    const QString header = QString::fromUtf8(begin, trimLine(begin, end) - begin);
+    QStringList names = header.split(';');
+    if (!names.isEmpty())
+        names.removeFirst();
+    return names;
+}
+
+/**
+  * Parse lines of samples into a dataset, in parallel.
+  *
+  * @param body Start of the first line.
+  * @param end End of the data.
+  * @param names Names of the columns of the dataset.
+  * @param dataset Dataset receiving the values.
+  * @param fieldColumns Column of the dataset receiving each field of the lines, -1 for
+  *                     the fields which are skipped. Empty if all the fields are kept.
+  */
+void CsvLoader::parseSamples(const char* body, const char* end, const QStringList& names, Dataset* dataset,
+                             const QVector<int>& fieldColumns)
+{
+    // Split the samples in chunks at line boundaries
+    const qint64 bodySize = end - body;
+    int nbChunks = QThread::idealThreadCount() * 4;
+    if (bodySize / nbChunks < MIN_CHUNK_SIZE)
+        nbChunks = (int) (bodySize / MIN_CHUNK_SIZE) + 1;
+
+    QVector<Chunk> chunks;
+    const char* chunkBegin = body;
+    for (int i = 0; i < nbChunks && chunkBegin < end; i++) {
+        const char* chunkEnd = end;
+        if (i < nbChunks - 1) {
+            chunkEnd = chunkBegin + bodySize / nbChunks;
+            if (chunkEnd < end)
+                chunkEnd = lineEnd(chunkEnd, end);
+            if (chunkEnd < end)
+                chunkEnd++;
+        }
+        Chunk chunk;
+        chunk.begin = chunkBegin;
+        chunk.end = chunkEnd;
+        chunk.firstSample = 0;
+        chunk.nbSamples = 0;
+        chunks.append(chunk);
+        chunkBegin = chunkEnd;
+    }
+
+    // Count the samples of each chunk
+    QtConcurrent::blockingMap(chunks, [](Chunk& chunk) {
+        chunk.nbSamples = countSamples(chunk.begin, chunk.end);
+    });
+    int nbSamples = 0;
+    for (int i = 0; i < chunks.size(); i++) {
+        chunks[i].firstSample = nbSamples;
+        nbSamples += chunks.at(i).nbSamples;
+    }
+
+    // Parse the values
+    dataset->allocate(names, nbSamples);
+    QtConcurrent::blockingMap(chunks, [dataset, &fieldColumns](Chunk& chunk) {
+        parseChunk(chunk, dataset, fieldColumns);
+    });
+    dataset->finalize();
+}
+
+/**
+  * Return the end of the line starting at begin (the '\n' or the end of the data).
+  */
+const char* CsvLoader::lineEnd(const char* begin, const char* end)
+{
+    const char* newLine = (const char*) memchr(begin, '\n', end - begin);
+    return (newLine != NULL) ? newLine : end;
+}
+
+/**
+  * Remove the carriage return of a line.
+  */
+const char* CsvLoader::trimLine(const char* begin, const char* lineEnd)
+{
+    if (lineEnd > begin && lineEnd[-1] == '\r')
+        return lineEnd - 1;
+    return lineEnd;
+}
+
+/**
+  * Count the non blank lines of a chunk.
+  */
+int CsvLoader::countSamples(const char* begin, const char* end)
+{
+    int nbSamples = 0;
+    while (begin < end) {
+        const char* next = lineEnd(begin, end);
+        if (trimLine(begin, next) > begin)
+            nbSamples++;
+        begin = next + 1;
+    }
+    return nbSamples;
+}
+
+/**
+  * Parse the lines of a chunk into the columns of the dataset. The values which
+  * are not numeric, and the fields missing at the end of a line, are stored as NaN.
+  * The skipped fields are only delimited, they are not parsed, and the end of the
+  * line after the last kept field is not read at all.
+  */
+void CsvLoader::parseChunk(const Chunk& chunk, Dataset* dataset, const QVector<int>& fieldColumns)
+{
+    const int nbColumns = dataset->getNbColumns();
+    QVector<float*> columns(nbColumns);
+    for (int i = 0; i < nbColumns; i++) {
+        columns[i] = dataset->columnData(i);
+    }
+
+    // Column receiving each field, up to the last kept one
+    QVector<int> fields = fieldColumns;
+    if (fields.isEmpty()) {
+        fields.resize(nbColumns);
+        for (int i = 0; i < nbColumns; i++) {
+            fields[i] = i;
+        }
+    }
+    while (!fields.isEmpty() && fields.last() < 0)
+        fields.removeLast();
+    const int nbFields = fields.size();
+
+    int sample = chunk.firstSample;
+    const char* begin = chunk.begin;
+    while (begin < chunk.end) {
+        const char* next = lineEnd(begin, chunk.end);
+        const char* end = trimLine(begin, next);
+        if (end > begin) {
+            // Skip the sample name
+            const char* field = (const char*) memchr(begin, ';', end - begin);
+            field = (field != NULL) ? field + 1 : end;
+
+            for (int i = 0; i < nbFields; i++) {
+                const int column = fields.at(i);
+                float value = qQNaN();
+                if (field <= end) {
+                    const char* separator = (const char*) memchr(field, ';', end - field);
+                    if (column >= 0) {
+                        const char* fieldEnd = (separator != NULL) ? separator : end;
+                        bool isOk = false;
+                        const float parsed = QByteArray::fromRawData(field, fieldEnd - field).toFloat(&isOk);
+                        if (isOk)
+                            value = parsed;
+                    }
+                    field = (separator != NULL) ? separator + 1 : end + 1;
+                }
+                if (column >= 0)
+                    columns[column][sample] = value;
+            }
+            sample++;
+        }
+        begin = next + 1;
+    }
+}
@@ -0,0 +1,67 @@
+/**
+  * @file   csvloader.h
+  * @author ReDS (Reconfigurable and embedded digital systems) <www.reds.ch>
+  * @author HEIG-VD (Haute école d'ingénierie et de gestion) <www.heig-vd.ch>
+  * @date   10.2026
+  * @section LICENSE
+  *
+  * This application is free software; you can redistribute it and/or
+  * modify it under the terms of the GNU Lesser General Public
+  * License as published by the Free Software Foundation; either
+  * version 2.1 of the License, or (at your option) any later version.
+  *
+  * This library is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  * Lesser General Public License for more details.
+  *
+  * You should have received a copy of the GNU Lesser General Public
+  * License along with this library; if not, write to the Free Software
+  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+  *
+  * @class CsvLoader
+  *
+  * @brief This class loads a ';' separated CSV file into a Dataset.
+  *
+  * @section DESCRIPTION
+  *
+  * The file is memory mapped and split in chunks at line boundaries. The lines and
+  * fields are located with memchr() (vectorized by the C library) and the chunks
+  * are parsed in parallel straight into the columns of the dataset, without
+  * creating a string per cell. The first line holds the columns names and the first
+  * column of each line (sample name) is skipped. Blank lines are ignored.
+  */
+
+#ifndef CSVLOADER_H
+#define CSVLOADER_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+#include "dataset.h"
+
+class CsvLoader
+{
+public:
+    static bool load(const QString& fileName, Dataset* dataset);
+    static QStringList parseHeader(const char* begin, const char* end);
+    static void parseSamples(const char* body, const char* end, const QStringList& names, Dataset* dataset,
+                             const QVector<int>& fieldColumns = QVector<int>());
+
+private:
+    struct Chunk {
+        const char* begin;
+        const char* end;
+        int firstSample;
+        int nbSamples;
+    };
+
+    static bool loadCompressed(const QString& fileName, Dataset* dataset);
+    static const char* lineEnd(const char* begin, const char* end);
+    static const char* trimLine(const char* begin, const char* lineEnd);
+    static int countSamples(const char* begin, const char* end);
+    static void parseChunk(const Chunk& chunk, Dataset* dataset, const QVector<int>& fieldColumns);
+};
+
+#endif // CSVLOADER_H
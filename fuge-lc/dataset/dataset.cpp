@@ -0,0 +1,337 @@
+/**
+  * @file   dataset.cpp
+  * @author ReDS (Reconfigurable and embedded digital systems) <www.reds.ch>
+  * @author HEIG-VD (Haute école d'ingénierie et de gestion) <www.heig-vd.ch>
+  * @date   10.2026
+  * @section LICENSE
+  *
+  * This application is free software; you can redistribute it and/or
+  * modify it under the terms of the GNU Lesser General Public
+  * License as published by the Free Software Foundation; either
+  * version 2.1 of the License, or (at your option) any later version.
+  *
+  * This library is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  * Lesser General Public License for more details.
+  *
+  * You should have received a copy of the GNU Lesser General Public
+  * License along with this library; if not, write to the Free Software
+  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+  *
+  *
+  * @class Dataset
+  *
+  * @brief This class holds a dataset as typed columns.
+  */
+
+#include <cassert>
+#include <cstring>
+#include <iostream>
+
+#include <QtConcurrent>
+#include <QtNumeric>
+
+#include "dataset.h"
+
+/**
+  * Constructor.
+  */
+Dataset::Dataset()
+{
+    nbSamples = 0;
+    missingWords = 0;
+    valuesData = NULL;
+    missingMaskData = NULL;
+    weightsData = NULL;
+    valuesStride = 0;
+    missingStride = 0;
+    mappedFile = NULL;
+}
+
+/**
+  * Destructor.
+  */
+Dataset::~Dataset()
+{
+    clear();
+}
+
+/**
+  * Remove all the columns and samples.
+  */
+void Dataset::clear()
+{
+    columnNames.clear();
+    columnIndexes.clear();
+    nbSamples = 0;
+    missingWords = 0;
+    values.clear();
+    missingMask.clear();
+    hasMissing.clear();
+    columnMin.clear();
+    columnMax.clear();
+    weights.clear();
+    valuesData = NULL;
+    missingMaskData = NULL;
+    weightsData = NULL;
+    valuesStride = 0;
+    missingStride = 0;
+    // Closing the file unmaps it
+    delete mappedFile;
+    mappedFile = NULL;
+}
+
+/**
+  * Allocate the storage of the dataset. The values must then be written with
+  * columnData(), missing values as NaN, before calling finalize().
+  *
+  * @param names Names of the columns.
+  * @param nbSamples Number of samples.
+  */
+void Dataset::allocate(const QStringList& names, int nbSamples)
+{
+    clear();
+
+    columnNames = names;
+    for (int i = 0; i < columnNames.size(); i++) {
+        columnIndexes.insert(columnNames.at(i), i);
+    }
+    this->nbSamples = nbSamples;
+    missingWords = (nbSamples + 63) / 64;
+    values.resize((qint64) columnNames.size()*nbSamples);
+    missingMask.fill(0, (qint64) columnNames.size()*missingWords);
+    hasMissing.fill(false, columnNames.size());
+    columnMin.fill(0.0, columnNames.size());
+    columnMax.fill(0.0, columnNames.size());
+    valuesData = values.constData();
+    missingMaskData = missingMask.constData();
+    valuesStride = nbSamples;
+    missingStride = missingWords;
+}
+
+/**
+  * Make this dataset a view on a block of samples of another dataset. The values
+  * are not copied, the source must outlive the view. The columns bounds are the
+  * ones of the whole source columns.
+  *
+  * @param source Dataset holding the values.
+  * @param firstSample First sample of the block, a multiple of 64.
+  * @param nbSamples Number of samples of the block.
+  */
+void Dataset::setView(const Dataset* source, int firstSample, int nbSamples)
+{
+    assert(firstSample % 64 == 0);
+
+    clear();
+
+    columnNames = source->columnNames;
+    columnIndexes = source->columnIndexes;
+    this->nbSamples = nbSamples;
+    missingWords = (nbSamples + 63) / 64;
+    hasMissing = source->hasMissing;
+    columnMin = source->columnMin;
+    columnMax = source->columnMax;
+    valuesData = source->valuesData + firstSample;
+    missingMaskData = source->missingMaskData + firstSample/64;
+    weightsData = (source->weightsData != NULL) ? source->weightsData + firstSample : NULL;
+    valuesStride = source->valuesStride;
+    missingStride = source->missingStride;
+}
+
+/**
+  * Collapse the identical samples (same values and same missing flags in all the
+  * columns, outputs included) into one sample whose weight is the number of its
+  * occurrences. The samples keep the order of their first occurrence and the
+  * columns bounds do not change. A mapped dataset is copied into memory.
+  *
+  * @return the number of distinct samples.
+  */
+int Dataset::collapseDuplicates()
+{
+    const int nbColumns = getNbColumns();
+
+    // Hash of each sample, computed in parallel by ranges of samples
+    QVector<quint64> hashes(nbSamples);
+    QVector<int> ranges;
+    for (int k = 0; k < nbSamples; k += 1 << 16) {
+        ranges.append(k);
+    }
+    QtConcurrent::blockingMap(ranges, [this, nbColumns, &hashes](int first) {
+        const int last = qMin(first + (1 << 16), nbSamples);
+        for (int k = first; k < last; k++) {
+            hashes[k] = Q_UINT64_C(14695981039346656037);
+        }
+        for (int i = 0; i < nbColumns; i++) {
+            const float* column = getColumn(i);
+            for (int k = first; k < last; k++) {
+                quint32 bits;
+                memcpy(&bits, column + k, sizeof(bits));
+                const quint64 key = ((quint64) isMissing(i, k) << 32) | bits;
+                hashes[k] = (hashes[k] ^ key) * Q_UINT64_C(1099511628211);
+            }
+        }
+    });
+
+    // Distinct samples, chained by hash to resolve the collisions
+    QHash<quint64, int> firstDistinct;
+    QVector<int> nextDistinct;
+    QVector<int> distinctSamples;
+    QVector<int> distinctWeights;
+    for (int k = 0; k < nbSamples; k++) {
+        int distinct = firstDistinct.value(hashes.at(k), -1);
+        int previous = -1;
+        while (distinct >= 0 && !sameSamples(distinctSamples.at(distinct), k)) {
+            previous = distinct;
+            distinct = nextDistinct.at(distinct);
+        }
+        if (distinct >= 0) {
+            distinctWeights[distinct] += getWeight(k);
+            continue;
+        }
+        distinct = distinctSamples.size();
+        distinctSamples.append(k);
+        distinctWeights.append(getWeight(k));
+        nextDistinct.append(-1);
+        if (previous >= 0)
+            nextDistinct[previous] = distinct;
+        else
+            firstDistinct.insert(hashes.at(k), distinct);
+    }
+
+    // Copy the distinct samples
+    const int nbDistinct = distinctSamples.size();
+    const int distinctWords = (nbDistinct + 63) / 64;
+    QVector<float> distinctValues((qint64) nbColumns*nbDistinct);
+    QVector<quint64> distinctMask((qint64) nbColumns*distinctWords, 0);
+    for (int i = 0; i < nbColumns; i++) {
+        float* column = distinctValues.data() + (qint64) i*nbDistinct;
+        quint64* mask = distinctMask.data() + (qint64) i*distinctWords;
+        for (int j = 0; j < nbDistinct; j++) {
+            const int sample = distinctSamples.at(j);
+            column[j] = getValue(i, sample);
+            if (isMissing(i, sample))
+                mask[j/64] |= Q_UINT64_C(1) << (j%64);
+        }
+    }
+
+    delete mappedFile;
+    mappedFile = NULL;
+    values.swap(distinctValues);
+    missingMask.swap(distinctMask);
+    weights.swap(distinctWeights);
+    nbSamples = nbDistinct;
+    missingWords = distinctWords;
+    valuesData = values.constData();
+    missingMaskData = missingMask.constData();
+    weightsData = weights.constData();
+    valuesStride = nbSamples;
+    missingStride = missingWords;
+
+    return nbDistinct;
+}
+
+/**
+  * Return true if two samples have the same values and missing flags in all the columns.
+  */
+bool Dataset::sameSamples(int first, int second) const
+{
+    for (int i = 0; i < getNbColumns(); i++) {
+        if (isMissing(i, first) != isMissing(i, second))
+            return false;
+        const float* column = getColumn(i);
+        if (memcmp(column + first, column + second, sizeof(float)) != 0)
+            return false;
+    }
+    return true;
+}
+
+/**
+  * Append the samples of another dataset after the samples of this one. Both
+  * datasets must have the same columns and must not be collapsed. A mapped dataset
+  * is copied into memory.
+  *
+  * @param samples Dataset holding the samples to be appended.
+  * @return false if the columns of the datasets differ.
+  */
+bool Dataset::append(const Dataset& samples)
+{
+    assert(!isWeighted() && !samples.isWeighted());
+    if (samples.getColumnNames() != columnNames) {
+        std::cout << "Error : the appended samples do not have the columns of the dataset" << std::endl;
+        return false;
+    }
+
+    // The missing values are written back as NaN to be flagged again by finalize()
+    const int nbColumns = getNbColumns();
+    const int nbFirst = nbSamples;
+    const int nbAppended = samples.getNbSamples();
+    QVector<float> merged((qint64) nbColumns*(nbFirst + nbAppended));
+    for (int i = 0; i < nbColumns; i++) {
+        float* column = merged.data() + (qint64) i*(nbFirst + nbAppended);
+        for (int k = 0; k < nbFirst; k++) {
+            column[k] = isMissing(i, k) ? qQNaN() : getValue(i, k);
+        }
+        for (int k = 0; k < nbAppended; k++) {
+            column[nbFirst + k] = samples.isMissing(i, k) ? qQNaN() : samples.getValue(i, k);
+        }
+    }
+
+    const QStringList names = columnNames;
+    allocate(names, nbFirst + nbAppended);
+    values.swap(merged);
+    valuesData = values.constData();
+    finalize();
+
+    return true;
+}
+
+/**
+  * Build the missing bitmasks and the bounds of all the columns once the values
+  * have been written. The columns are processed in parallel.
+  */
+void Dataset::finalize()
+{
+    QVector<int> columns(columnNames.size());
+    for (int i = 0; i < columns.size(); i++) {
+        columns[i] = i;
+    }
+    QtConcurrent::blockingMap(columns, [this](int column) { finalizeColumn(column); });
+}
+
+/**
+  * Replace the NaN values of a column by 0, flag them in the missing bitmask and
+  * compute the bounds of the column.
+  *
+  * @param column Index of the column.
+  */
+void Dataset::finalizeColumn(int column)
+{
+    float* data = columnData(column);
+    quint64* mask = missingMask.data() + column*missingStride;
+    float valMin = 0.0;
+    float valMax = 0.0;
+    bool first = true;
+
+    for (int k = 0; k < nbSamples; k++) {
+        const float value = data[k];
+        if (qIsNaN(value)) {
+            data[k] = 0.0;
+            mask[k/64] |= Q_UINT64_C(1) << (k%64);
+            hasMissing[column] = true;
+        }
+        else if (first) {
+            valMin = value;
+            valMax = value;
+            first = false;
+        }
+        else {
+            if (value < valMin)
+                valMin = value;
+            if (value > valMax)
+                valMax = value;
+        }
+    }
+    columnMin[column] = valMin;
+    columnMax[column] = valMax;
+}
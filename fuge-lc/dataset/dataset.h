@@ -0,0 +1,119 @@
+/**
+  * @file   dataset.h
+  * @author ReDS (Reconfigurable and embedded digital systems) <www.reds.ch>
+  * @author HEIG-VD (Haute école d'ingénierie et de gestion) <www.heig-vd.ch>
+  * @date   10.2026
+  * @section LICENSE
+  *
+  * This application is free software; you can redistribute it and/or
+  * modify it under the terms of the GNU Lesser General Public
+  * License as published by the Free Software Foundation; either
+  * version 2.1 of the License, or (at your option) any later version.
+  *
+  * This library is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  * Lesser General Public License for more details.
+  *
+  * You should have received a copy of the GNU Lesser General Public
+  * License along with this library; if not, write to the Free Software
+  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+  *
+  * @class Dataset
+  *
+  * @brief This class holds a dataset as typed columns. The first column of the CSV
+  * file (samples names) is not kept, column 0 is the first variable.
+  *
+  * @section DESCRIPTION
+  *
+  * The values are stored column by column as floats. A value which is not numeric
+  * is missing : it is stored as 0 and flagged in the missing bitmask of its column
+  * (one bit per sample). The bounds of each column do not take the missing values
+  * into account.
+  *
+  * The values and the bitmasks are either owned by the dataset (CSV loaded by
+  * CsvLoader) or read straight from a memory mapped cache file (see DatasetCache).
+  * A dataset can also be a view on a block of samples of another dataset (see
+  * setView()), in which case the columns are not contiguous.
+  *
+  * The identical samples can be collapsed into one weighted sample (see
+  * collapseDuplicates()). The weight of a sample is the number of samples of the
+  * CSV file it stands for, 1 when the dataset has not been collapsed.
+  *
+  * The samples added at the end of a CSV file can be appended to the dataset
+  * already loaded (see append()), without reading its first samples again.
+  */
+
+#ifndef DATASET_H
+#define DATASET_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QHash>
+#include <QFile>
+
+class Dataset
+{
+public:
+    Dataset();
+    ~Dataset();
+
+    void clear();
+    void allocate(const QStringList& names, int nbSamples);
+    void finalize();
+    void setView(const Dataset* source, int firstSample, int nbSamples);
+    int collapseDuplicates();
+    bool append(const Dataset& samples);
+
+    int getNbColumns() const {return columnNames.size();}
+    int getNbSamples() const {return nbSamples;}
+    int getMissingWords() const {return missingWords;}
+    const QStringList& getColumnNames() const {return columnNames;}
+    QString getColumnName(int column) const {return columnNames.at(column);}
+    int getColumnIndex(const QString& name) const {return columnIndexes.value(name, -1);}
+
+    const float* getColumn(int column) const {return valuesData + column*valuesStride;}
+    float* columnData(int column) {return values.data() + column*valuesStride;}
+    float getValue(int column, int sample) const {return valuesData[column*valuesStride + sample];}
+
+    const quint64* getMissingMask(int column) const {return missingMaskData + column*missingStride;}
+    bool isMissing(int column, int sample) const
+    {
+        return (missingMaskData[column*missingStride + sample/64] >> (sample%64)) & 1;
+    }
+    bool columnHasMissing(int column) const {return hasMissing.at(column);}
+    float getColumnMin(int column) const {return columnMin.at(column);}
+    float getColumnMax(int column) const {return columnMax.at(column);}
+
+    bool isWeighted() const {return weightsData != NULL;}
+    int getWeight(int sample) const {return (weightsData != NULL) ? weightsData[sample] : 1;}
+
+private:
+    QStringList columnNames;
+    QHash<QString, int> columnIndexes;
+    int nbSamples;
+    int missingWords;
+    QVector<float> values;
+    QVector<quint64> missingMask;
+    QVector<bool> hasMissing;
+    QVector<float> columnMin;
+    QVector<float> columnMax;
+    QVector<int> weights;
+
+    // Storage actually read : the vectors above, the mapped cache file or the
+    // storage of the dataset this one is a view on
+    const float* valuesData;
+    const quint64* missingMaskData;
+    const int* weightsData;
+    qint64 valuesStride;
+    qint64 missingStride;
+    QFile* mappedFile;
+
+    void finalizeColumn(int column);
+    bool sameSamples(int first, int second) const;
+
+    friend class DatasetCache;
+};
+
+#endif // DATASET_H
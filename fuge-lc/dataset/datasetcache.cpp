@@ -0,0 +1,331 @@
+/**
+  * @file   datasetcache.cpp
+  * @author ReDS (Reconfigurable and embedded digital systems) <www.reds.ch>
+  * @author HEIG-VD (Haute école d'ingénierie et de gestion) <www.heig-vd.ch>
+  * @date   10.2026
+  * @section LICENSE
+  *
+  * This application is free software; you can redistribute it and/or
+  * modify it under the terms of the GNU Lesser General Public
+  * License as published by the Free Software Foundation; either
+  * version 2.1 of the License, or (at your option) any later version.
+  *
+  * This library is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  * Lesser General Public License for more details.
+  *
+  * You should have received a copy of the GNU Lesser General Public
+  * License along with this library; if not, write to the Free Software
+  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+  *
+  *
+  * @class DatasetCache
+  *
+  * @brief This class stores a Dataset in a binary columnar file next to its CSV file.
+  */
+
+#include <cstring>
+#include <iostream>
+
+#include <QFile>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QSaveFile>
+#include <QCryptographicHash>
+
+#include "datasetcache.h"
+#include "csvloader.h"
+#include "decompressdevice.h"
+
+#define CACHE_MAGIC "FUGEDSC"
+#define CACHE_VERSION 1
+#define CACHE_BYTE_ORDER 0x01020304
+// Alignment of the sections of the file, a multiple of the memory pages sizes
+#define CACHE_ALIGNMENT 4096
+// Size of the head and of the tail of the CSV file included in the hash
+#define CACHE_HASH_BLOCK (64 * 1024)
+
+/**
+  * Return the name of the cache file of a CSV file.
+  *
+  * @param csvName Name of the CSV file.
+  */
+QString DatasetCache::cacheFileName(const QString& csvName)
+{
+    return csvName + ".fcache";
+}
+
+/**
+  * Map the cache file of a CSV file into a dataset.
+  *
+  * @param csvName Name of the CSV file.
+  * @param dataset Dataset receiving the values.
+  * @return false if there is no valid cache for the current CSV file.
+  */
+bool DatasetCache::load(const QString& csvName, Dataset* dataset)
+{
+    Header key;
+    if (!readKey(csvName, &key))
+        return false;
+    return mapCache(csvName, key, dataset);
+}
+
+/**
+  * Load the dataset of a CSV file to which samples have been appended since its
+  * cache file was written. The cached samples are mapped, only the appended lines
+  * of the CSV file are parsed, then the cache file is written again.
+  *
+  * @param csvName Name of the CSV file.
+  * @param dataset Dataset receiving the values.
+  * @return false if the head of the CSV file is not the one of the cache, or if the
+  *         file is compressed.
+  */
+bool DatasetCache::loadAppended(const QString& csvName, Dataset* dataset)
+{
+    // The appended bytes of a compressed file are not CSV lines
+    if (DecompressDevice::formatOf(csvName) != DecompressDevice::Plain)
+        return false;
+
+    Header key;
+    QFile cacheFile(cacheFileName(csvName));
+    if (!cacheFile.open(QIODevice::ReadOnly) ||
+            cacheFile.read((char*) &key, sizeof(Header)) != sizeof(Header))
+        return false;
+    cacheFile.close();
+
+    // The CSV file must have grown by whole lines
+    QFile csvFile(csvName);
+    if (!csvFile.open(QIODevice::ReadOnly) || csvFile.size() <= key.csvSize || key.csvSize <= 0)
+        return false;
+    char hash[sizeof(key.csvHash)];
+    char lastChar = 0;
+    if (!hashHeadAndTail(&csvFile, key.csvSize, hash) || memcmp(hash, key.csvHash, sizeof(hash)) != 0 ||
+            !csvFile.seek(key.csvSize - 1) || !csvFile.getChar(&lastChar) || lastChar != '\n')
+        return false;
+
+    if (!mapCache(csvName, key, dataset))
+        return false;
+
+    // Parse the appended lines
+    const qint64 appendedSize = csvFile.size() - key.csvSize;
+    QByteArray buffer;
+    const char* data = (const char*) csvFile.map(key.csvSize, appendedSize);
+    if (data == NULL) {
+        csvFile.seek(key.csvSize);
+        buffer = csvFile.read(appendedSize);
+        data = buffer.constData();
+    }
+    Dataset samples;
+    CsvLoader::parseSamples(data, data + appendedSize, dataset->getColumnNames(), &samples);
+    if (!dataset->append(samples)) {
+        dataset->clear();
+        return false;
+    }
+
+    save(csvName, *dataset);
+    return true;
+}
+
+/**
+  * Map a cache file into a dataset.
+  *
+  * @param csvName Name of the CSV file.
+  * @param key Header holding the key of the CSV file the cache must match.
+  * @param dataset Dataset receiving the values.
+  * @return false if the cache file is missing, invalid or does not match the key.
+  */
+bool DatasetCache::mapCache(const QString& csvName, const Header& key, Dataset* dataset)
+{
+    QFile* file = new QFile(cacheFileName(csvName));
+    if (!file->open(QIODevice::ReadOnly)) {
+        delete file;
+        return false;
+    }
+    const qint64 size = file->size();
+    const uchar* data = (size >= (qint64) sizeof(Header)) ? file->map(0, size) : NULL;
+    if (data == NULL) {
+        delete file;
+        return false;
+    }
+
+    // Check the format and the key of the CSV file
+    const Header* header = (const Header*) data;
+    const qint64 columnsSize = (qint64) header->nbColumns;
+    if (memcmp(header->magic, CACHE_MAGIC, sizeof(header->magic)) != 0 ||
+            header->version != CACHE_VERSION || header->byteOrder != CACHE_BYTE_ORDER ||
+            header->fileSize != size || header->csvSize != key.csvSize ||
+            header->csvModified != key.csvModified ||
+            memcmp(header->csvHash, key.csvHash, sizeof(header->csvHash)) != 0 ||
+            header->nbColumns <= 0 || header->nbSamples < 0 ||
+            header->missingWords != (header->nbSamples + 63) / 64 ||
+            header->namesOffset + header->namesSize > size ||
+            header->valuesOffset + columnsSize*header->nbSamples*(qint64) sizeof(float) > size ||
+            header->missingOffset + columnsSize*header->missingWords*(qint64) sizeof(quint64) > size ||
+            header->boundsOffset + columnsSize*(2*(qint64) sizeof(float) + 1) > size) {
+        delete file;
+        return false;
+    }
+
+    QStringList names = QString::fromUtf8((const char*) data + header->namesOffset, header->namesSize).split(';');
+    if (names.size() != header->nbColumns) {
+        delete file;
+        return false;
+    }
+
+    dataset->clear();
+    dataset->columnNames = names;
+    for (int i = 0; i < names.size(); i++) {
+        dataset->columnIndexes.insert(names.at(i), i);
+    }
+    dataset->nbSamples = header->nbSamples;
+    dataset->missingWords = header->missingWords;
+    dataset->valuesData = (const float*) (data + header->valuesOffset);
+    dataset->missingMaskData = (const quint64*) (data + header->missingOffset);
+    dataset->valuesStride = header->nbSamples;
+    dataset->missingStride = header->missingWords;
+
+    const float* mins = (const float*) (data + header->boundsOffset);
+    const float* maxs = mins + header->nbColumns;
+    const uchar* hasMissing = (const uchar*) (maxs + header->nbColumns);
+    dataset->columnMin.resize(header->nbColumns);
+    dataset->columnMax.resize(header->nbColumns);
+    dataset->hasMissing.resize(header->nbColumns);
+    for (int i = 0; i < header->nbColumns; i++) {
+        dataset->columnMin[i] = mins[i];
+        dataset->columnMax[i] = maxs[i];
+        dataset->hasMissing[i] = (hasMissing[i] != 0);
+    }
+
+    // The dataset keeps the file open as long as it reads the mapping
+    dataset->mappedFile = file;
+
+    return true;
+}
+
+/**
+  * Write the cache file of a CSV file.
+  *
+  * @param csvName Name of the CSV file the dataset has been loaded from.
+  * @param dataset Dataset to be stored.
+  * @return false if the cache cannot be written.
+  */
+bool DatasetCache::save(const QString& csvName, const Dataset& dataset)
+{
+    Header header;
+    memset(&header, 0, sizeof(Header));
+    if (dataset.getNbColumns() == 0 || !readKey(csvName, &header))
+        return false;
+
+    const QByteArray names = dataset.getColumnNames().join(';').toUtf8();
+    const qint64 nbColumns = dataset.getNbColumns();
+    const qint64 valuesSize = nbColumns*dataset.getNbSamples()*sizeof(float);
+    const qint64 missingSize = nbColumns*dataset.getMissingWords()*sizeof(quint64);
+
+    memcpy(header.magic, CACHE_MAGIC, sizeof(header.magic));
+    header.version = CACHE_VERSION;
+    header.byteOrder = CACHE_BYTE_ORDER;
+    header.nbColumns = dataset.getNbColumns();
+    header.nbSamples = dataset.getNbSamples();
+    header.missingWords = dataset.getMissingWords();
+    header.namesSize = names.size();
+    header.namesOffset = align(sizeof(Header));
+    header.valuesOffset = align(header.namesOffset + names.size());
+    header.missingOffset = align(header.valuesOffset + valuesSize);
+    header.boundsOffset = align(header.missingOffset + missingSize);
+    header.fileSize = header.boundsOffset + nbColumns*(2*sizeof(float) + 1);
+
+    QVector<float> mins(nbColumns);
+    QVector<float> maxs(nbColumns);
+    QByteArray hasMissing(nbColumns, 0);
+    for (int i = 0; i < nbColumns; i++) {
+        mins[i] = dataset.getColumnMin(i);
+        maxs[i] = dataset.getColumnMax(i);
+        hasMissing[i] = dataset.columnHasMissing(i) ? 1 : 0;
+    }
+
+    QSaveFile file(cacheFileName(csvName));
+    if (!file.open(QIODevice::WriteOnly)) {
+        std::cout << "Error : cannot write the dataset cache " << cacheFileName(csvName).toStdString() << std::endl;
+        return false;
+    }
+    bool isOk = file.write((const char*) &header, sizeof(Header)) == sizeof(Header) &&
+            writePadding(&file, header.namesOffset - sizeof(Header)) &&
+            file.write(names) == names.size() &&
+            writePadding(&file, header.valuesOffset - header.namesOffset - names.size()) &&
+            file.write((const char*) dataset.getColumn(0), valuesSize) == valuesSize &&
+            writePadding(&file, header.missingOffset - header.valuesOffset - valuesSize) &&
+            file.write((const char*) dataset.getMissingMask(0), missingSize) == missingSize &&
+            writePadding(&file, header.boundsOffset - header.missingOffset - missingSize) &&
+            file.write((const char*) mins.constData(), nbColumns*sizeof(float)) == nbColumns*(qint64) sizeof(float) &&
+            file.write((const char*) maxs.constData(), nbColumns*sizeof(float)) == nbColumns*(qint64) sizeof(float) &&
+            file.write(hasMissing) == nbColumns;
+    if (!isOk || !file.commit()) {
+        std::cout << "Error : cannot write the dataset cache " << cacheFileName(csvName).toStdString() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+  * Fill the key fields of a header (size, modification time and hash of the head
+  * and the tail) from the CSV file.
+  *
+  * @return false if the CSV file cannot be read.
+  */
+bool DatasetCache::readKey(const QString& csvName, Header* header)
+{
+    QFile csvFile(csvName);
+    if (!csvFile.open(QIODevice::ReadOnly))
+        return false;
+
+    QFileInfo info(csvName);
+    header->csvSize = info.size();
+    header->csvModified = info.lastModified().toMSecsSinceEpoch();
+
+    return hashHeadAndTail(&csvFile, header->csvSize, header->csvHash);
+}
+
+/**
+  * Hash the head and the tail of the first bytes of a CSV file.
+  *
+  * @param csvFile Opened CSV file.
+  * @param size Number of bytes of the file taken into account.
+  * @param hash Buffer receiving the 20 bytes of the hash.
+  * @return false if the file cannot be read.
+  */
+bool DatasetCache::hashHeadAndTail(QFile* csvFile, qint64 size, char* hash)
+{
+    QCryptographicHash hasher(QCryptographicHash::Sha1);
+    if (!csvFile->seek(0))
+        return false;
+    hasher.addData(csvFile->read(qMin(size, (qint64) CACHE_HASH_BLOCK)));
+    if (size > CACHE_HASH_BLOCK) {
+        const qint64 tail = qMax((qint64) CACHE_HASH_BLOCK, size - CACHE_HASH_BLOCK);
+        if (!csvFile->seek(tail))
+            return false;
+        hasher.addData(csvFile->read(size - tail));
+    }
+    const QByteArray result = hasher.result();
+    memset(hash, 0, sizeof(Header::csvHash));
+    memcpy(hash, result.constData(), qMin((qint64) result.size(), (qint64) sizeof(Header::csvHash)));
+
+    return true;
+}
+
+/**
+  * Round an offset up to the next section boundary.
+  */
+qint64 DatasetCache::align(qint64 offset)
+{
+    return (offset + CACHE_ALIGNMENT - 1) / CACHE_ALIGNMENT * CACHE_ALIGNMENT;
+}
+
+/**
+  * Write size zero bytes.
+  */
+bool DatasetCache::writePadding(QIODevice* device, qint64 size)
+{
+    const QByteArray padding(size, 0);
+    return device->write(padding) == size;
+}
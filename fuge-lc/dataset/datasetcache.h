@@ -0,0 +1,89 @@
+/**
+  * @file   datasetcache.h
+  * @author ReDS (Reconfigurable and embedded digital systems) <www.reds.ch>
+  * @author HEIG-VD (Haute école d'ingénierie et de gestion) <www.heig-vd.ch>
+  * @date   10.2026
+  * @section LICENSE
+  *
+  * This application is free software; you can redistribute it and/or
+  * modify it under the terms of the GNU Lesser General Public
+  * License as published by the Free Software Foundation; either
+  * version 2.1 of the License, or (at your option) any later version.
+  *
+  * This library is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  * Lesser General Public License for more details.
+  *
+  * You should have received a copy of the GNU Lesser General Public
+  * License along with this library; if not, write to the Free Software
+  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+  *
+  *
+  * @class DatasetCache
+  *
+  * @brief This class stores a Dataset in a binary columnar file next to its CSV file,
+  * so that later runs map it instead of parsing the CSV again.
+  *
+  * @section DESCRIPTION
+  *
+  * The cache file (CSV name followed by ".fcache") starts with a Header followed by
+  * the sections below, each one starting on a CACHE_ALIGNMENT boundary :
+  *  - the columns names, UTF-8 and ';' separated,
+  *  - the values, column by column,
+  *  - the missing values bitmasks, column by column,
+  *  - the minimums, the maximums and the missing values flags of the columns.
+  *
+  * The file is mapped read-only and the dataset reads the values and the bitmasks
+  * directly from the mapping, so concurrent processes share the same pages of the
+  * OS page cache. The cache is only used when it matches the size, the modification
+  * time and a hash of the head and the tail of the CSV file, otherwise it is written
+  * again (atomically, with QSaveFile). When lines have only been appended to the CSV
+  * file, the head and the tail of its previous content still match the hash, so the
+  * cached samples are kept and only the appended lines are parsed (see loadAppended()).
+  */
+
+#ifndef DATASETCACHE_H
+#define DATASETCACHE_H
+
+#include <QString>
+#include <QByteArray>
+#include <QFile>
+
+#include "dataset.h"
+
+class DatasetCache
+{
+public:
+    static QString cacheFileName(const QString& csvName);
+    static bool load(const QString& csvName, Dataset* dataset);
+    static bool save(const QString& csvName, const Dataset& dataset);
+    static bool loadAppended(const QString& csvName, Dataset* dataset);
+
+private:
+    struct Header {
+        char magic[8];
+        quint32 version;
+        quint32 byteOrder;
+        qint64 csvSize;
+        qint64 csvModified;
+        char csvHash[20];
+        qint32 nbColumns;
+        qint32 nbSamples;
+        qint32 missingWords;
+        qint32 namesSize;
+        qint64 namesOffset;
+        qint64 valuesOffset;
+        qint64 missingOffset;
+        qint64 boundsOffset;
+        qint64 fileSize;
+    };
+
+    static bool mapCache(const QString& csvName, const Header& key, Dataset* dataset);
+    static bool readKey(const QString& csvName, Header* header);
+    static bool hashHeadAndTail(QFile* csvFile, qint64 size, char* hash);
+    static qint64 align(qint64 offset);
+    static bool writePadding(QIODevice* device, qint64 size);
+};
+
+#endif // DATASETCACHE_H
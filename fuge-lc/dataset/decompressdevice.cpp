@@ -0,0 +1,442 @@
+/**
+  * @file   decompressdevice.cpp
+  * @author ReDS (Reconfigurable and embedded digital systems) <www.reds.ch>
+  * @author HEIG-VD (Haute école d'ingénierie et de gestion) <www.heig-vd.ch>
+  * @date   10.2026
+  * @section LICENSE
+  *
+  * This application is free software; you can redistribute it and/or
+  * modify it under the terms of the GNU Lesser General Public
+  * License as published by the Free Software Foundation; either
+  * version 2.1 of the License, or (at your option) any later version.
+  *
+  * This library is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  * Lesser General Public License for more details.
+  *
+  * You should have received a copy of the GNU Lesser General Public
+  * License along with this library; if not, write to the Free Software
+  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+  *
+  *
+  *
+  * @class DecompressDevice
+  *
+  * @brief This class reads a gzip (.gz) or zstd (.zst) compressed file as a sequential
+  * device delivering the decompressed bytes.
+  */
+
+#include <cstring>
+#include <iostream>
+
+#include <QMutexLocker>
+#include <QThread>
+#include <QtConcurrent>
+
+#ifdef FUGE_HAVE_ZLIB
+#include <zlib.h>
+#endif
+#ifdef FUGE_HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+#include "decompressdevice.h"
+
+// Size of the chunks read from the compressed file and of the decompressed chunks
+#define CHUNK_SIZE (1 << 20)
+// Maximal size of the decompressed data waiting to be read
+#define MAX_QUEUED_SIZE (16 << 20)
+// Maximal decompressed size of a zstd frame decompressed at once
+#define MAX_FRAME_SIZE (32 << 20)
+
+/**
+  * Constructor.
+  *
+  * @param fileName Name of the compressed file.
+  */
+DecompressDevice::DecompressDevice(const QString& fileName) :
+    file(fileName),
+    format(formatOf(fileName)),
+    chunkOffset(0),
+    queuedSize(0),
+    finished(true),
+    stopping(false),
+    corrupted(false)
+{
+}
+
+/**
+  * Destructor.
+  */
+DecompressDevice::~DecompressDevice()
+{
+    close();
+}
+
+/**
+  * Return the compression format of a file, according to its suffix.
+  */
+DecompressDevice::Format DecompressDevice::formatOf(const QString& fileName)
+{
+    if (fileName.endsWith(".gz", Qt::CaseInsensitive))
+        return Gzip;
+    if (fileName.endsWith(".zst", Qt::CaseInsensitive))
+        return Zstd;
+    return Plain;
+}
+
+/**
+  * Return true if this build of FUGE-LC can decompress the given format.
+  */
+bool DecompressDevice::isSupported(Format format)
+{
+    switch (format) {
+    case Gzip:
+#ifdef FUGE_HAVE_ZLIB
+        return true;
+#else
+        return false;
+#endif
+    case Zstd:
+#ifdef FUGE_HAVE_ZSTD
+        return true;
+#else
+        return false;
+#endif
+    default:
+        return false;
+    }
+}
+
+/**
+  * Return true if the decompression stopped on corrupted or truncated data.
+  */
+bool DecompressDevice::isCorrupted() const
+{
+    QMutexLocker locker(&mutex);
+    return corrupted;
+}
+
+/**
+  * Open the compressed file and start its decompression. Only the reading is supported.
+  *
+  * @return false if the file cannot be read or its format is not supported.
+  */
+bool DecompressDevice::open(OpenMode mode)
+{
+    if ((mode & QIODevice::WriteOnly) || isOpen())
+        return false;
+    if (!isSupported(format)) {
+        std::cout << "Error : FUGE-LC was built without the support of the compressed file "
+                  << file.fileName().toStdString() << std::endl;
+        return false;
+    }
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    chunks.clear();
+    chunkOffset = 0;
+    queuedSize = 0;
+    finished = false;
+    stopping = false;
+    corrupted = false;
+    QIODevice::open(QIODevice::ReadOnly);
+
+    producer = QtConcurrent::run([this]() { decompress(); });
+    return true;
+}
+
+/**
+  * Stop the decompression and close the file.
+  */
+void DecompressDevice::close()
+{
+    if (!isOpen())
+        return;
+
+    mutex.lock();
+    stopping = true;
+    chunkRead.wakeAll();
+    mutex.unlock();
+    producer.waitForFinished();
+
+    file.close();
+    chunks.clear();
+    queuedSize = 0;
+    QIODevice::close();
+}
+
+/**
+  * Return true once all the decompressed data has been read.
+  */
+bool DecompressDevice::atEnd() const
+{
+    QMutexLocker locker(&mutex);
+    return !isOpen() || (finished && chunks.isEmpty() && QIODevice::bytesAvailable() == 0);
+}
+
+/**
+  * Return the number of decompressed bytes which can be read without waiting.
+  */
+qint64 DecompressDevice::bytesAvailable() const
+{
+    QMutexLocker locker(&mutex);
+    return queuedSize + QIODevice::bytesAvailable();
+}
+
+/**
+  * Copy decompressed bytes, waiting for the decompression thread if no chunk is ready.
+  *
+  * @return The number of bytes copied, 0 at the end of the data.
+  */
+qint64 DecompressDevice::readData(char* data, qint64 maxSize)
+{
+    QMutexLocker locker(&mutex);
+    while (chunks.isEmpty() && !finished)
+        chunkQueued.wait(&mutex);
+
+    qint64 size = 0;
+    while (size < maxSize && !chunks.isEmpty()) {
+        const QByteArray& chunk = chunks.first();
+        const qint64 copied = qMin(maxSize - size, (qint64) chunk.size() - chunkOffset);
+        memcpy(data + size, chunk.constData() + chunkOffset, copied);
+        size += copied;
+        chunkOffset += copied;
+        if (chunkOffset == chunk.size()) {
+            chunks.removeFirst();
+            chunkOffset = 0;
+        }
+    }
+    queuedSize -= size;
+    chunkRead.wakeAll();
+    return size;
+}
+
+/**
+  * The device is read only.
+  */
+qint64 DecompressDevice::writeData(const char* data, qint64 maxSize)
+{
+    Q_UNUSED(data);
+    Q_UNUSED(maxSize);
+    return -1;
+}
+
+/**
+  * Body of the decompression thread.
+  */
+void DecompressDevice::decompress()
+{
+    const bool isOk = (format == Gzip) ? decompressGzip() : decompressZstd();
+    if (!isOk)
+        std::cout << "Error : the compressed file " << file.fileName().toStdString() << " is corrupted" << std::endl;
+
+    QMutexLocker locker(&mutex);
+    finished = true;
+    corrupted = !isOk;
+    chunkQueued.wakeAll();
+}
+
+/**
+  * Return true if the device is being closed and the decompression must stop.
+  */
+bool DecompressDevice::isStopping()
+{
+    QMutexLocker locker(&mutex);
+    return stopping;
+}
+
+/**
+  * Queue a decompressed chunk, waiting while too much data is waiting to be read.
+  *
+  * @return false if the device is being closed and the decompression must stop.
+  */
+bool DecompressDevice::pushChunk(const QByteArray& chunk)
+{
+    QMutexLocker locker(&mutex);
+    while (queuedSize >= MAX_QUEUED_SIZE && !stopping)
+        chunkRead.wait(&mutex);
+    if (stopping)
+        return false;
+
+    chunks.append(chunk);
+    queuedSize += chunk.size();
+    chunkQueued.wakeAll();
+    return true;
+}
+
+/**
+  * Decompress a gzip file. Concatenated gzip members (pigz, cat of .gz files) are
+  * decompressed one after the other.
+  *
+  * @return false if the file is corrupted or truncated.
+  */
+bool DecompressDevice::decompressGzip()
+{
+#ifdef FUGE_HAVE_ZLIB
+    z_stream stream;
+    memset(&stream, 0, sizeof(stream));
+    // Maximal window, gzip or zlib header detected automatically
+    if (inflateInit2(&stream, 15 + 32) != Z_OK)
+        return false;
+
+    QByteArray input;
+    input.resize(CHUNK_SIZE);
+    bool isOk = true;
+    bool memberEnd = false;
+    while (true) {
+        if (stream.avail_in == 0) {
+            const qint64 size = file.read(input.data(), input.size());
+            if (size <= 0) {
+                isOk = memberEnd;
+                break;
+            }
+            stream.next_in = (Bytef*) input.data();
+            stream.avail_in = (uInt) size;
+        }
+        if (memberEnd) {
+            inflateReset(&stream);
+            memberEnd = false;
+        }
+
+        QByteArray output;
+        output.resize(CHUNK_SIZE);
+        stream.next_out = (Bytef*) output.data();
+        stream.avail_out = CHUNK_SIZE;
+        const int ret = inflate(&stream, Z_NO_FLUSH);
+        if (ret != Z_OK && ret != Z_STREAM_END && ret != Z_BUF_ERROR) {
+            isOk = false;
+            break;
+        }
+        memberEnd = (ret == Z_STREAM_END);
+
+        output.resize(CHUNK_SIZE - stream.avail_out);
+        if (!output.isEmpty() && !pushChunk(output))
+            break;
+    }
+
+    inflateEnd(&stream);
+    return isOk;
+#else
+    return false;
+#endif
+}
+
+#ifdef FUGE_HAVE_ZSTD
+namespace {
+    // zstd frame decompressed at once by a thread of the pool
+    struct ZstdFrame {
+        const char* data;
+        qint64 size;
+        QByteArray output;
+        bool isOk;
+    };
+}
+#endif
+
+/**
+  * Decompress a zstd file frame by frame. The consecutive frames whose decompressed
+  * size is stored in their header, and not too large, are decompressed in parallel
+  * by batches of one frame per thread. The other frames are streamed.
+  *
+  * @return false if the file is corrupted or truncated.
+  */
+bool DecompressDevice::decompressZstd()
+{
+#ifdef FUGE_HAVE_ZSTD
+    QByteArray buffer;
+    const char* data = (const char*) file.map(0, file.size());
+    const char* end = data + file.size();
+    if (data == NULL) {
+        buffer = file.readAll();
+        data = buffer.constData();
+        end = data + buffer.size();
+    }
+
+    const int batchSize = QThread::idealThreadCount();
+    while (data < end && !isStopping()) {
+        QVector<ZstdFrame> frames;
+        const char* next = data;
+        while (next < end && frames.size() < batchSize) {
+            const size_t frameSize = ZSTD_findFrameCompressedSize(next, end - next);
+            if (ZSTD_isError(frameSize))
+                break;
+            const unsigned long long contentSize = ZSTD_getFrameContentSize(next, frameSize);
+            if (contentSize == ZSTD_CONTENTSIZE_UNKNOWN || contentSize == ZSTD_CONTENTSIZE_ERROR ||
+                contentSize > MAX_FRAME_SIZE)
+                break;
+            ZstdFrame frame;
+            frame.data = next;
+            frame.size = frameSize;
+            frame.output.resize((int) contentSize);
+            frame.isOk = false;
+            frames.append(frame);
+            next += frameSize;
+        }
+
+        if (frames.isEmpty()) {
+            const size_t frameSize = ZSTD_findFrameCompressedSize(data, end - data);
+            if (ZSTD_isError(frameSize) || !decompressZstdFrame(data, frameSize))
+                return false;
+            data += frameSize;
+            continue;
+        }
+
+        QtConcurrent::blockingMap(frames, [](ZstdFrame& frame) {
+            const size_t size = ZSTD_decompress(frame.output.data(), frame.output.size(), frame.data, frame.size);
+            frame.isOk = !ZSTD_isError(size) && size == (size_t) frame.output.size();
+        });
+        for (int i = 0; i < frames.size(); i++) {
+            if (!frames.at(i).isOk)
+                return false;
+            if (!frames.at(i).output.isEmpty() && !pushChunk(frames.at(i).output))
+                return true;
+        }
+        data = next;
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+  * Stream a complete zstd frame.
+  *
+  * @param data Start of the frame.
+  * @param size Compressed size of the frame.
+  * @return false if the frame is corrupted.
+  */
+bool DecompressDevice::decompressZstdFrame(const char* data, qint64 size)
+{
+#ifdef FUGE_HAVE_ZSTD
+    ZSTD_DStream* stream = ZSTD_createDStream();
+    ZSTD_initDStream(stream);
+    ZSTD_inBuffer input = {data, (size_t) size, 0};
+
+    bool isOk = true;
+    size_t ret = 1;
+    // ret is 0 once the frame is entirely decompressed and flushed
+    while (ret != 0) {
+        QByteArray output;
+        output.resize(CHUNK_SIZE);
+        ZSTD_outBuffer out = {output.data(), (size_t) output.size(), 0};
+        ret = ZSTD_decompressStream(stream, &out, &input);
+        if (ZSTD_isError(ret) || (ret != 0 && input.pos == input.size && out.pos < out.size)) {
+            isOk = false;
+            break;
+        }
+        output.resize((int) out.pos);
+        if (!output.isEmpty() && !pushChunk(output))
+            break;
+    }
+
+    ZSTD_freeDStream(stream);
+    return isOk;
+#else
+    Q_UNUSED(data);
+    Q_UNUSED(size);
+    return false;
+#endif
+}
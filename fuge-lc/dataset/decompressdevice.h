@@ -0,0 +1,97 @@
+/**
+  * @file   decompressdevice.h
+  * @author ReDS (Reconfigurable and embedded digital systems) <www.reds.ch>
+  * @author HEIG-VD (Haute école d'ingénierie et de gestion) <www.heig-vd.ch>
+  * @date   10.2026
+  * @section LICENSE
+  *
+  * This application is free software; you can redistribute it and/or
+  * modify it under the terms of the GNU Lesser General Public
+  * License as published by the Free Software Foundation; either
+  * version 2.1 of the License, or (at your option) any later version.
+  *
+  * This library is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  * Lesser General Public License for more details.
+  *
+  * You should have received a copy of the GNU Lesser General Public
+  * License along with this library; if not, write to the Free Software
+  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+  *
+  *
+  *
+  * @class DecompressDevice
+  *
+  * @brief This class reads a gzip (.gz) or zstd (.zst) compressed file as a sequential
+  * device delivering the decompressed bytes.
+  *
+  * @section DESCRIPTION
+  *
+  * The decompression runs in its own thread, a bounded number of decompressed chunks
+  * ahead of the reader, so that it overlaps with the parsing of the data already
+  * read. The zstd frames of a known size (files written by pzstd or zstd with
+  * independent frames) are decompressed in parallel, the other frames are streamed.
+  *
+  * The support of each format is only available when FUGE-LC is built with the
+  * corresponding library (FUGE_HAVE_ZLIB, FUGE_HAVE_ZSTD).
+  */
+
+#ifndef DECOMPRESSDEVICE_H
+#define DECOMPRESSDEVICE_H
+
+#include <QIODevice>
+#include <QFile>
+#include <QFuture>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QList>
+#include <QByteArray>
+
+class DecompressDevice : public QIODevice
+{
+public:
+    enum Format {Plain, Gzip, Zstd};
+
+    DecompressDevice(const QString& fileName);
+    ~DecompressDevice();
+
+    static Format formatOf(const QString& fileName);
+    static bool isSupported(Format format);
+    bool isCorrupted() const;
+
+    bool open(OpenMode mode) override;
+    void close() override;
+    bool isSequential() const override {return true;}
+    bool atEnd() const override;
+    qint64 bytesAvailable() const override;
+
+protected:
+    qint64 readData(char* data, qint64 maxSize) override;
+    qint64 writeData(const char* data, qint64 maxSize) override;
+
+private:
+    QFile file;
+    Format format;
+    QFuture<void> producer;
+
+    // Decompressed chunks not read yet, shared with the decompression thread
+    mutable QMutex mutex;
+    QWaitCondition chunkQueued;
+    QWaitCondition chunkRead;
+    QList<QByteArray> chunks;
+    qint64 chunkOffset;
+    qint64 queuedSize;
+    bool finished;
+    bool stopping;
+    bool corrupted;
+
+    void decompress();
+    bool decompressGzip();
+    bool decompressZstd();
+    bool decompressZstdFrame(const char* data, qint64 size);
+    bool isStopping();
+    bool pushChunk(const QByteArray& chunk);
+};
+
+#endif // DECOMPRESSDEVICE_H
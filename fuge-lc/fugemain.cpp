@@ -24,13 +24,18 @@
   *
   * @brief This class implements the FUGE-LC main window.
   */
+#include <QtConcurrent>
+
 #include "fugemain.h"
 #include "QAction.h"
 
 
 QFile *fitLogFile;
 QSemaphore scriptSema(0);
-QList<QStringList>* FugeMain::listFile = 0;
+Dataset* FugeMain::dataset = 0;
+
+// Number of samples evaluated at once by streamEvaluation(), a multiple of 64
+#define STREAM_BLOCK_SIZE (64 * 1024)
 
 FugeMain::FugeMain()
     : fSystemRules(0), fSystemVars(0)
@@ -40,11 +45,12 @@ FugeMain::FugeMain()
     scriptLoaded = false;
     paramsLoaded = false;
     isRunning = false;
+    fixedPointDeviation = 0.0;
 
     ComputeThread::bestFSystem = 0;
     fSystemRules = 0;
     fSystemVars = 0;
-    listFile = new QList<QStringList>;
+    dataset = new Dataset();
 
     CoevStats& fitStats = CoevStats::getInstance();
     sMan = new ScriptManager();
@@ -59,7 +65,7 @@ FugeMain::FugeMain()
 
 FugeMain::~FugeMain()
 {
-    delete listFile;
+    delete dataset;
     sMan->deleteLater();
 }
 
@@ -70,31 +76,18 @@ FugeMain::~FugeMain()
   *
   * @param dataSet Dataset on which the evolution/evaluation/prediction is performed
   * @param fuzzyFile Name of the fuzzy system specified on the command line (if any)
+  * @param outputFile Name of the file receiving the evaluation/prediction results (if any)
   * @param eval Evaluation mode flag
   * @param predict Prediction mode flag
   * @param verbose Verbose mode flag
   */
-void FugeMain::runFromCmdLine(QString dataSet, QString scriptFile, QString fuzzyFile,
+void FugeMain::runFromCmdLine(QString dataSet, QString scriptFile, QString fuzzyFile, QString outputFile,
                         bool eval, bool predict, bool verbose)
 {
-    // First open the dataset
-    QFile file(dataSet);
-    file.open(QIODevice::ReadOnly);
-    QTextStream csvFile(&file);
-    QString line;
-    QStringList list;
-
-    // Read the csv file and store info in a double dimension list.
-    while (!csvFile.atEnd()) {
-        line = csvFile.readLine();
-        list = line.split(';');
-        listFile->append(list);
-    }
-    dataLoaded = true;
-
     // Set the dataset name in the parameters
     SystemParameters& sysParams = SystemParameters::getInstance();
     sysParams.setVerbose(verbose);
+    outputFileName = outputFile;
 
     // Check whether we make an evolution or a validation/prediction
     if (eval || predict) {
@@ -126,12 +119,24 @@ void FugeMain::runFromCmdLine(QString dataSet, QString scriptFile, QString fuzzy
             std::cout << "[MDM] : " << ComputeThread::bestFSystem->getDistanceMinThreshold() << std::endl;
             std::cout << "[SIZE] : " << ComputeThread::bestFSystem->getDontCare() << std::endl;
             std::cout << "[OverLearn] : " << ComputeThread::bestFSystem->getOverLearn() << std::endl;
+            if (sysParams.getReducedPrecision()) {
+                std::cout << "[FixedPointDeviation] : " << fixedPointDeviation << std::endl;
+            }
         }
         else if (predict) {
             this->onActPredictFuzzy();
         }
     }
     else {
+        // The evaluation and the prediction stream the dataset, an evolution loads it at once
+        loadDataset(dataSet);
+        if (sysParams.getCollapseDuplicates()) {
+            const int nbSamples = dataset->getNbSamples();
+            const int nbDistinct = dataset->collapseDuplicates();
+            std::cout << "[DistinctSamples] : " << nbDistinct << " / " << nbSamples << std::endl;
+        }
+        dataLoaded = true;
+
         // Then open the script
         scriptLoaded = true;
         sMan->setScriptFileName(scriptFile);
@@ -210,20 +215,42 @@ void FugeMain::setDefaultSysParams()
 
 /**
  * @brief FugeMain::getNewFuzzySystem Returns a new fuzzy system fully loaded.
- * @param listFile
+ * @param dataset
  * @return a new loaded SystemFuzzy
  */
-FuzzySystem* FugeMain::getNewFuzzySystem(QList<QStringList>* listFile){
+FuzzySystem* FugeMain::getNewFuzzySystem(Dataset* dataset){
     FuzzySystem *fSystem = new FuzzySystem();
     ComputeThread::sysParams = &SystemParameters::getInstance();
     fSystem->setParameters(ComputeThread::sysParams->getNbRules(), ComputeThread::sysParams->getNbVarPerRule(), ComputeThread::sysParams->getNbOutVars(),
                       ComputeThread::sysParams->getNbInSets(), ComputeThread::sysParams->getNbOutSets(), ComputeThread::sysParams->getInVarsCodeSize(),
                       ComputeThread::sysParams->getOutVarsCodeSize(), ComputeThread::sysParams->getInSetsCodeSize(), ComputeThread::sysParams->getOutSetsCodeSize(),
                       ComputeThread::sysParams->getInSetsPosCodeSize(), ComputeThread::sysParams->getOutSetPosCodeSize());
-    fSystem->loadData(listFile);
+    fSystem->loadData(dataset);
     return fSystem;
 }
 
+/**
+  * Load a CSV dataset, from its cache file when the cache is enabled and valid.
+  * When samples have only been appended to the CSV file, the cached samples are
+  * kept and the appended ones are parsed.
+  *
+  * @param fileName Name of the CSV file.
+  * @return false if the dataset cannot be read.
+  */
+bool FugeMain::loadDataset(const QString& fileName)
+{
+    SystemParameters& sysParams = SystemParameters::getInstance();
+
+    if (sysParams.getDatasetCache() &&
+            (DatasetCache::load(fileName, dataset) || DatasetCache::loadAppended(fileName, dataset)))
+        return true;
+    if (!CsvLoader::load(fileName, dataset))
+        return false;
+    if (sysParams.getDatasetCache())
+        DatasetCache::save(fileName, *dataset);
+    return true;
+}
+
 /**
   * Method called when a run needs to be performed. It sets the interface to the required
   * sate and runs the computation thread.
@@ -239,8 +266,8 @@ void FugeMain::onActRun()
 
     if ((dataLoaded && scriptLoaded) || (dataLoaded && paramsLoaded)) {
 
-        fSystemVars = getNewFuzzySystem(listFile);
-        fSystemRules = getNewFuzzySystem(listFile);
+        fSystemVars = getNewFuzzySystem(dataset);
+        fSystemRules = getNewFuzzySystem(dataset);
 
         // At least attribute it a pointer.
         ComputeThread::bestFSystem = fSystemVars;
@@ -269,63 +296,15 @@ void FugeMain::onActRun()
 }
 
 /**
-  * Slot called when the user asks for a prediction.
+  * Slot called when the user asks for a prediction. The predictions are written to
+  * the output file, or to the standard output if there is none.
   */
 void FugeMain::onActPredictFuzzy()
 {
     SystemParameters& sysParams = SystemParameters::getInstance();
     QString fileName = sysParams.getDatasetName();
 
-    if (dataLoaded)
-        listFile->clear();
-    QFile file(fileName);
-    file.open(QIODevice::ReadOnly);
-    QTextStream csvFile(&file);
-    QString line;
-    QStringList list;
-
-    // Read the csv file and store info in a double dimension list.
-    while (!csvFile.atEnd()) {
-        line = csvFile.readLine();
-        list = line.split(';');
-        listFile->append(list);
-    }
-    ComputeThread::bestFSystem->loadData(listFile);
-    dataLoaded = true;
-
-    file.close();
-
-    int nbOutVars = sysParams.getNbOutVars();
-
-    QVector<float> computedResults;
-    QVector<float> reverseComputedResults;
-    QVector<float> predictedResults;
-
-    computedResults = ComputeThread::bestFSystem->doEvaluateFitness();
-
-
-    // Reorder the results in order to simplify their display by EvalPlot
-    if(nbOutVars > 1) {
-        reverseComputedResults.resize(computedResults.size());
-        for (int i = 0; i <  nbOutVars; i++) {
-            for (int k = 0; k < listFile->size()-1; k++) {
-                reverseComputedResults.replace(i*(listFile->size()-1) + k, computedResults.at(k*nbOutVars+i));
-            }
-        }
-    }
-    else {
-        reverseComputedResults.resize(computedResults.size());
-        for (int k = 0; k < listFile->size()-1; k++) {
-            reverseComputedResults.replace(k, computedResults.at(k));
-        }
-    }
-
-    predictedResults.resize(reverseComputedResults.size());
-    // Compute the predicted results by applying the threshold
-    for (int i = 0; i < reverseComputedResults.size(); i++) {
-        predictedResults.replace(i, ComputeThread::bestFSystem->threshold(i / (reverseComputedResults.size()/nbOutVars), reverseComputedResults.at(i)));
-    }
-    qDebug() << "Predicted results : " << predictedResults;
+    streamEvaluation(fileName, outputFileName.isEmpty() ? QString("-") : outputFileName);
 }
 
 
@@ -334,10 +313,6 @@ void FugeMain::onActPredictFuzzy()
   */
 void FugeMain::onActEvalFuzzy(bool doValid)
 {
-    QVector<float> computedResults;
-    QVector<float> reverseComputedResults;
-    QVector<float> expectedResults;
-    QVector<float> predictedResults;
     SystemParameters& sysParams = SystemParameters::getInstance();
 
     QString fileName;
@@ -345,70 +320,124 @@ void FugeMain::onActEvalFuzzy(bool doValid)
     if (doValid) {
         // Retrieve the dataset corresponding to the system according to the name in the XML
         fileName = sysParams.getDatasetName();
-        QFile file(fileName);
     }
     else {
         fileName = "blabla.ffs"; /* QFileDialog::getOpenFileName(this, tr("Open a test dataset"), "../../../../datasets", "*.csv");*/
     }
 
-    QFile file(fileName);
-    if (file.open(QIODevice::ReadOnly)) {
-        // Clear previous loaded data
-        if (dataLoaded)
-            listFile->clear();
-        QTextStream csvFile(&file);
-        QString line;
-        QStringList list;
-
-        // Read the csv file and store info in a double dimension list.
-        while (!csvFile.atEnd()) {
-            line = csvFile.readLine();
-            list = line.split(';');
-            listFile->append(list);
-         }       
+    if (sysParams.getReducedPrecision()) {
+        // Floating point reference of the fixed point evaluation
+        ComputeThread::bestFSystem->setFixedPoint(false);
+        const float floatFitness = streamEvaluation(fileName, QString());
+        ComputeThread::bestFSystem->setFixedPoint(true);
+        fixedPointDeviation = streamEvaluation(fileName, outputFileName) - floatFitness;
     }
-    ComputeThread::bestFSystem->loadData(listFile);
-    dataLoaded = true;
-    file.close();
-
-    int nbOutVars = sysParams.getNbOutVars();
-    int nbInVars = listFile->at(0).size() - 1 - nbOutVars;
+    else {
+        streamEvaluation(fileName, outputFileName);
+    }
+}
 
-    expectedResults.resize((listFile->size()-1)*nbOutVars);
+/**
+  * Evaluate the best fuzzy system on a dataset read by blocks of samples, so that the
+  * memory used does not depend on the size of the dataset. The next block is parsed
+  * while the current one is evaluated and the results of each block are written as
+  * soon as it is evaluated. When the dataset cache is enabled, the blocks are views
+  * on the mapped cache file instead.
+  *
+  * @param fileName Name of the CSV file.
+  * @param outputName File receiving the defuzzified values and the classes of the
+  *                   samples, "-" for the standard output, empty for no output.
+  * @return the fitness of the system over all the samples.
+  */
+float FugeMain::streamEvaluation(const QString& fileName, const QString& outputName)
+{
+    SystemParameters& sysParams = SystemParameters::getInstance();
+    FuzzySystem* fSystem = ComputeThread::bestFSystem;
+    const int nbOutVars = sysParams.getNbOutVars();
+
+    CsvBlockReader reader;
+    const bool mapped = sysParams.getDatasetCache();
+    if (mapped) {
+        if (!loadDataset(fileName))
+            return 0.0;
+    }
+    else if (reader.open(fileName)) {
+        // Only parse the input variables used by the rules and the output variables
+        // (last columns), the mapped cache only reads the pages of the used columns
+        const QStringList& names = reader.getColumnNames();
+        QVector<bool> keptColumns(names.size());
+        for (int i = 0; i < names.size(); i++) {
+            FuzzyVariable* fVar = fSystem->getInVarByName(names.at(i));
+            keptColumns[i] = (i >= names.size() - nbOutVars) || (fVar != NULL && fVar->isUsedBySystem());
+        }
+        reader.setProjection(keptColumns);
+    }
+    else {
+        return 0.0;
+    }
+    dataLoaded = true;
 
-    if (/*dataLoaded*/1) {
+    int nextSample = 0;
+    auto readBlock = [&](Dataset* block) -> bool {
+        if (!mapped)
+            return reader.readBlock(STREAM_BLOCK_SIZE, block);
+        const int nbSamples = qMin(STREAM_BLOCK_SIZE, dataset->getNbSamples() - nextSample);
+        if (nbSamples <= 0)
+            return false;
+        block->setView(dataset, nextSample, nbSamples);
+        nextSample += nbSamples;
+        return true;
+    };
+
+    QFile output;
+    if (outputName == "-") {
+        output.open(stdout, QIODevice::WriteOnly);
+    }
+    else if (!outputName.isEmpty()) {
+        output.setFileName(outputName);
+        if (!output.open(QIODevice::WriteOnly))
+            std::cout << "Error : cannot write the results to " << outputName.toStdString() << std::endl;
+    }
+    if (output.isOpen()) {
+        QByteArray header = "Sample";
         for (int k = 0; k < nbOutVars; k++) {
-            for (int i = 1, j = 0; i < listFile->size(); i++, j++) {
-                expectedResults.replace((listFile->size()-1)*k + j, (listFile->at(i).at(nbInVars+k+1)).toFloat());
-            }
+            const QByteArray name = fSystem->getOutVar(k)->getName().toUtf8();
+            header += ";" + name + ";" + name + "_class";
         }
+        output.write(header + "\n");
+    }
 
-        computedResults = ComputeThread::bestFSystem->doEvaluateFitness();
-
-        predictedResults.resize(computedResults.size());
-
-        // Reorder the results in order to simplify their display by EvalPlot
-        if(nbOutVars > 1) {
-            reverseComputedResults.resize(computedResults.size());
-            for (int i = 0; i <  nbOutVars; i++) {
-                for (int k = 0; k < listFile->size()-1; k++) {
-                    reverseComputedResults.replace(i*(listFile->size()-1) + k, computedResults.at(k*nbOutVars+i));
+    fSystem->beginEvaluation();
+    int current = 0;
+    int firstSample = 0;
+    bool hasBlock = readBlock(&streamBlocks[current]);
+    while (hasBlock) {
+        Dataset* block = &streamBlocks[current];
+        QFuture<bool> next = QtConcurrent::run(readBlock, &streamBlocks[1 - current]);
+
+        fSystem->loadData(block);
+        fSystem->evaluateSamples();
+
+        if (output.isOpen()) {
+            const QVector<float>& computed = fSystem->getComputedResults();
+            QByteArray lines;
+            for (int i = 0; i < block->getNbSamples(); i++) {
+                lines += QByteArray::number(firstSample + i + 1);
+                for (int k = 0; k < nbOutVars; k++) {
+                    const float value = computed.at(i*nbOutVars + k);
+                    lines += ";" + QByteArray::number(value) + ";" + QByteArray::number(fSystem->threshold(k, value));
                 }
+                lines += "\n";
             }
+            output.write(lines);
         }
-        else {
-            reverseComputedResults.resize(computedResults.size());
-            for (int k = 0; k < listFile->size()-1; k++) {
-                reverseComputedResults.replace(k, computedResults.at(k));
-            }
-        }
+        firstSample += block->getNbSamples();
 
-        // Compute the predicted results by applying the threshold
-        predictedResults.resize(reverseComputedResults.size());
-        for (int i = 0; i < reverseComputedResults.size(); i++) {
-            predictedResults.replace(i, ComputeThread::bestFSystem->threshold(i / (reverseComputedResults.size()/nbOutVars), reverseComputedResults.at(i)));
-        }
+        hasBlock = next.result();
+        current = 1 - current;
     }
+
+    return fSystem->endEvaluation();
 }
 
 /**
@@ -431,17 +460,17 @@ void FugeMain::onComputeFinished()
     QTextStream newNameStream(&newName);
     QTime time;
     QString fileN;
-    // Ensure that a temp directory exists. If not we create one.
-    QDir tempDir;
-    if (!tempDir.exists(sysParams.getSavePath()+"temp")) {
-        tempDir.mkdir(sysParams.getSavePath()+"temp");
-    }
-    fileN = QString(sysParams.getSavePath()+"temp/currentBest_") +
-            QString::number(QCoreApplication::applicationPid()) + QString(".ffs");
+    // Also the file of the periodic saves of the run, overwritten by the final system
+    fileN = ComputeThread::currentBestFileName();
     QFile file(fileN);
     CoevStats& stats = CoevStats::getInstance();
     ComputeThread::bestFSystem->saveToFile(fileN, stats.getFitMaxPop1());
 
+    // Report the deviation of the reduced precision evaluation on the training data
+    if (sysParams.getReducedPrecision()) {
+        std::cout << "[FixedPointDeviation] : " << ComputeThread::bestFSystem->measureFixedPointDeviation() << std::endl;
+    }
+
     // Ensure that a fuzzy systems directory exists. If not we create one.
     QDir logsDir;
     if (!logsDir.exists(sysParams.getSavePath()+"fuzzySystems")) {
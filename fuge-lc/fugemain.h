@@ -45,6 +45,9 @@
 #include <QProcess>
 
 #include "fuzzysystem.h"
+#include "csvloader.h"
+#include "datasetcache.h"
+#include "csvblockreader.h"
 
 #include "computethread.h"
 #include "scriptmanager.h"
@@ -68,13 +71,15 @@ public:
     FugeMain();
     ~FugeMain();
 
-    void runFromCmdLine(QString dataSet, QString scriptFile, QString fuzzyFile,
+    void runFromCmdLine(QString dataSet, QString scriptFile, QString fuzzyFile, QString outputFile,
                         bool eval, bool predict, bool verbose);
-    static QList<QStringList>* listFile;
-    static FuzzySystem* getNewFuzzySystem(QList<QStringList>* listFile);
+    static Dataset* dataset;
+    static FuzzySystem* getNewFuzzySystem(Dataset* dataset);
 
 private:
     void createActions();
+    bool loadDataset(const QString& fileName);
+    float streamEvaluation(const QString& fileName, const QString& outputName);
     ComputeThread* computeThread;
 
     FuzzySystem* fSystemVars;
@@ -86,6 +91,10 @@ private:
     QAction* actPredictFuzzy;
 
     QString currentOpennedSystem;
+    QString outputFileName;
+    float fixedPointDeviation;
+    // Blocks of samples of the streamed evaluations, one evaluated while the other is read
+    Dataset streamBlocks[2];
     void setDefaultSysParams();
 
     bool fuzzyLoaded;
@@ -13,7 +13,8 @@ SOURCES += $$PWD/fuzzyvariable.cpp \
     $$PWD/defuzzmethodcoa.cpp \
     $$PWD/fuzzysystem.cpp \
     $$PWD/fuzzymembershipsgenome.cpp \
-    $$PWD/defuzzmethodsingleton.cpp
+    $$PWD/defuzzmethodsingleton.cpp \
+    $$PWD/fuzzykernels.cpp
 
 HEADERS += $$PWD/fuzzyvariable.h \
     $$PWD/fuzzyset.h \
@@ -27,6 +28,7 @@ HEADERS += $$PWD/fuzzyvariable.h \
     $$PWD/defuzzmethodcoa.h \
     $$PWD/fuzzysystem.h \
     $$PWD/fuzzymembershipsgenome.h \
-    $$PWD/defuzzmethodsingleton.h
+    $$PWD/defuzzmethodsingleton.h \
+    $$PWD/fuzzykernels.h
 
 
@@ -0,0 +1,172 @@
+/**
+  * @file   fuzzykernels.cpp
+  * @author ReDS (Reconfigurable and embedded digital systems) <www.reds.ch>
+  * @author HEIG-VD (Haute école d'ingénierie et de gestion) <www.heig-vd.ch>
+  * @date   10.2026
+  * @section LICENSE
+  *
+  * This application is free software; you can redistribute it and/or
+  * modify it under the terms of the GNU Lesser General Public
+  * License as published by the Free Software Foundation; either
+  * version 2.1 of the License, or (at your option) any later version.
+  *
+  * This library is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  * Lesser General Public License for more details.
+  *
+  * You should have received a copy of the GNU Lesser General Public
+  * License along with this library; if not, write to the Free Software
+  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+  *
+  * @brief Generic evaluation kernels and kernels selection.
+  */
+
+#include "fuzzykernels.h"
+
+namespace FuzzyKernels
+{
+
+void cocoDegreesGeneric(const double* positions, int nbSets, double value, double* degrees)
+{
+    for (int s = 0; s < nbSets; s++)
+        degrees[s] = cocoDegree(positions, nbSets - 1, value, s);
+}
+
+void cocoDegreesFixedGeneric(const quint16* positions, const quint32* reciprocals, int nbSets, quint32 value, quint16* degrees)
+{
+    for (int s = 0; s < nbSets; s++)
+        degrees[s] = cocoDegreeFixed(positions, reciprocals, nbSets - 1, value, s);
+}
+
+double ruleFireGeneric(const double* degrees, const int* antecedents, int nbAntecedents)
+{
+    if (nbAntecedents == 0)
+        return 0.0;
+
+    double eval = degrees[antecedents[0]];
+    for (int i = 1; i < nbAntecedents; i++) {
+        const double d = degrees[antecedents[i]];
+        eval = (eval <= d) ? eval : d;
+    }
+    return (eval <= 1.0) ? eval : 0.0;
+}
+
+quint16 ruleFireFixedGeneric(const quint16* degrees, const quint16* missing, const int* antecedents,
+                             const int* antecedentVars, int nbAntecedents)
+{
+    quint16 eval = FIXED_ONE;
+    quint16 present = 0;
+    for (int i = 0; i < nbAntecedents; i++) {
+        const quint16 mask = missing[antecedentVars[i]];
+        const quint16 d = degrees[antecedents[i]] | mask;
+        eval = (eval <= d) ? eval : d;
+        present |= ~mask;
+    }
+    return present ? eval : 0;
+}
+
+double singletonDefuzzGeneric(const double* evals, const double* positions, int nbSets)
+{
+    double evalSum = 0.0;
+    double evalProduct = 0.0;
+    for (int i = 0; i < nbSets; i++) {
+        evalSum += evals[i];
+        evalProduct += evals[i] * positions[i];
+    }
+    if (evalSum == 0.0)
+        return 0.0;
+    return evalProduct / evalSum;
+}
+
+/**
+  * Select the kernels matching the shape of a system.
+  *
+  * @param nbInSets Number of sets of the input variables.
+  * @param nbOutSets Number of sets of the output variables.
+  */
+KernelSet select(int nbInSets, int nbOutSets)
+{
+    KernelSet kernels;
+
+    kernels.nbInSets = nbInSets;
+    kernels.nbOutSets = nbOutSets;
+
+    switch (nbInSets) {
+        case 2:
+            kernels.degrees = &cocoDegrees<2>;
+            kernels.degreesFixed = &cocoDegreesFixed<2>;
+        break;
+        case 3:
+            kernels.degrees = &cocoDegrees<3>;
+            kernels.degreesFixed = &cocoDegreesFixed<3>;
+        break;
+        case 4:
+            kernels.degrees = &cocoDegrees<4>;
+            kernels.degreesFixed = &cocoDegreesFixed<4>;
+        break;
+        default:
+            kernels.degrees = &cocoDegreesGeneric;
+            kernels.degreesFixed = &cocoDegreesFixedGeneric;
+        break;
+    }
+
+    switch (nbOutSets) {
+        case 2:
+            kernels.defuzz = &singletonDefuzz<2>;
+        break;
+        default:
+            kernels.defuzz = &singletonDefuzzGeneric;
+        break;
+    }
+
+    return kernels;
+}
+
+/**
+  * Select the kernel computing the fire level of a rule.
+  *
+  * @param nbAntecedents Number of antecedents of the rule.
+  */
+RuleKernel ruleKernel(int nbAntecedents)
+{
+    switch (nbAntecedents) {
+        case 0:
+            return &ruleFire<0>;
+        case 1:
+            return &ruleFire<1>;
+        case 2:
+            return &ruleFire<2>;
+        case 3:
+            return &ruleFire<3>;
+        case 4:
+            return &ruleFire<4>;
+        default:
+            return &ruleFireGeneric;
+    }
+}
+
+/**
+  * Select the fixed point kernel computing the fire level of a rule.
+  *
+  * @param nbAntecedents Number of antecedents of the rule.
+  */
+RuleFixedKernel ruleFixedKernel(int nbAntecedents)
+{
+    switch (nbAntecedents) {
+        case 0:
+            return &ruleFireFixed<0>;
+        case 1:
+            return &ruleFireFixed<1>;
+        case 2:
+            return &ruleFireFixed<2>;
+        case 3:
+            return &ruleFireFixed<3>;
+        case 4:
+            return &ruleFireFixed<4>;
+        default:
+            return &ruleFireFixedGeneric;
+    }
+}
+
+}
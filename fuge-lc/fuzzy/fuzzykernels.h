@@ -0,0 +1,278 @@
+/**
+  * @file   fuzzykernels.h
+  * @author ReDS (Reconfigurable and embedded digital systems) <www.reds.ch>
+  * @author HEIG-VD (Haute école d'ingénierie et de gestion) <www.heig-vd.ch>
+  * @date   10.2026
+  * @section LICENSE
+  *
+  * This application is free software; you can redistribute it and/or
+  * modify it under the terms of the GNU Lesser General Public
+  * License as published by the Free Software Foundation; either
+  * version 2.1 of the License, or (at your option) any later version.
+  *
+  * This library is distributed in the hope that it will be useful,
+  * but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  * Lesser General Public License for more details.
+  *
+  * You should have received a copy of the GNU Lesser General Public
+  * License along with this library; if not, write to the Free Software
+  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+  *
+  * @brief Evaluation kernels used by FuzzySystem on its flattened representation.
+  *
+  * @section DESCRIPTION
+  *
+  * The kernels compute the same values as FuzzyMembershipsCoco::evaluateSet(),
+  * FuzzyOperatorAND and DefuzzMethodSingleton, but work on plain arrays of positions
+  * and degrees instead of going through the variables and sets objects. The most
+  * common sizes (2 to 4 input sets, 2 output sets, up to 4 antecedents per rule) are
+  * instantiated with compile-time bounds so that their loops are fully unrolled.
+  * Other shapes fall back to the generic versions. The kernels are selected once by
+  * select() and ruleKernel(), not for every sample.
+  *
+  * The fixed point kernels are used by the reduced precision mode. Inputs, positions and
+  * degrees are then unsigned 16 bits values : the inputs and positions on the universe of
+  * each variable, the degrees as fixed point numbers where FIXED_ONE stands for 1.0. The
+  * slopes of the sets are given by a reciprocal of the distance between two positions,
+  * computed once per system, so that no degree needs a division. A missing input has no
+  * degree : it is flagged by a mask of its variable, FIXED_MISSING_MASK when the value is
+  * missing and 0 otherwise.
+  */
+
+#ifndef FUZZYKERNELS_H
+#define FUZZYKERNELS_H
+
+#include <QtGlobal>
+
+namespace FuzzyKernels
+{
+    typedef void (*DegreesKernel)(const double* positions, int nbSets, double value, double* degrees);
+    typedef double (*RuleKernel)(const double* degrees, const int* antecedents, int nbAntecedents);
+    typedef double (*DefuzzKernel)(const double* evals, const double* positions, int nbSets);
+    typedef void (*DegreesFixedKernel)(const quint16* positions, const quint32* reciprocals, int nbSets, quint32 value, quint16* degrees);
+    typedef quint16 (*RuleFixedKernel)(const quint16* degrees, const quint16* missing, const int* antecedents,
+                                       const int* antecedentVars, int nbAntecedents);
+
+    /**
+      * Set of kernels matching a given system shape.
+      */
+    struct KernelSet {
+        int nbInSets;
+        int nbOutSets;
+        DegreesKernel degrees;
+        DegreesFixedKernel degreesFixed;
+        DefuzzKernel defuzz;
+    };
+
+    // Degree given to all the sets of a missing input value. As it is greater
+    // than any valid degree, it is ignored by the AND and the rule is dropped
+    // when all of its antecedents are missing.
+    const double MISSING_DEGREE = 2.0;
+
+    // Fixed point representation of 1.0
+    const quint16 FIXED_ONE = 0xFFFF;
+    // Fixed point input value marking a missing value, and mask of the variable
+    // of a missing value
+    const quint16 FIXED_MISSING_INPUT = 0xFFFF;
+    const quint16 FIXED_MISSING_MASK = 0xFFFF;
+
+    /**
+      * Evaluate one "Fuzzy Coco" set (see FuzzyMembershipsCoco::evaluateSet()).
+      *
+      * @param positions Sorted positions of the sets of the variable.
+      * @param lastSet Index of the last set of the variable.
+      * @param value Input value.
+      * @param setNum Number of the set to be evaluated.
+      */
+    inline double cocoDegree(const double* positions, const int lastSet, const double value, const int setNum)
+    {
+        const double position = positions[setNum];
+
+        if (value == position)
+            return 1.0;
+
+        if (setNum == lastSet || (setNum != 0 && value < position)) {
+            if (value > position)
+                return 1.0;
+            const double beforePosition = positions[setNum-1];
+            if (value <= beforePosition)
+                return 0.0;
+            return (value - beforePosition) / (position - beforePosition);
+        }
+        else {
+            if (value < position)
+                return 1.0;
+            const double afterPosition = positions[setNum+1];
+            if (value >= afterPosition)
+                return 0.0;
+            return 1.0 - ((value - position) / (afterPosition - position));
+        }
+    }
+
+    /**
+      * Evaluate all the sets of an input variable for a given value.
+      *
+      * @param positions Sorted positions of the sets of the variable.
+      * @param nbSets Number of sets (ignored, NbSets is used instead).
+      * @param value Input value.
+      * @param degrees Output array receiving one degree per set.
+      */
+    template <int NbSets>
+    void cocoDegrees(const double* positions, int /*nbSets*/, double value, double* degrees)
+    {
+        for (int s = 0; s < NbSets; s++)
+            degrees[s] = cocoDegree(positions, NbSets - 1, value, s);
+    }
+
+    void cocoDegreesGeneric(const double* positions, int nbSets, double value, double* degrees);
+
+    /**
+      * Reciprocal of the distance between two positions, scaled so that the degree
+      * of a value at the offset d from the first one is (d * reciprocal) >> 16. As d
+      * is smaller than the distance, the product fits on 32 bits.
+      *
+      * @param distance Distance between the two positions, 0 for sets at the same position.
+      */
+    inline quint32 fixedReciprocal(quint32 distance)
+    {
+        return (distance == 0) ? 0 : ((quint32) FIXED_ONE << 16) / distance;
+    }
+
+    /**
+      * Fixed point version of cocoDegree().
+      *
+      * @param positions Sorted positions of the sets of the variable.
+      * @param reciprocals Reciprocals of the distances between two consecutive positions.
+      * @param lastSet Index of the last set of the variable.
+      * @param value Input value.
+      * @param setNum Number of the set to be evaluated.
+      */
+    inline quint16 cocoDegreeFixed(const quint16* positions, const quint32* reciprocals, const int lastSet,
+                                   const quint32 value, const int setNum)
+    {
+        const quint32 position = positions[setNum];
+
+        if (value == position)
+            return FIXED_ONE;
+
+        if (setNum == lastSet || (setNum != 0 && value < position)) {
+            if (value > position)
+                return FIXED_ONE;
+            const quint32 beforePosition = positions[setNum-1];
+            if (value <= beforePosition)
+                return 0;
+            return ((value - beforePosition) * reciprocals[setNum-1]) >> 16;
+        }
+        else {
+            if (value < position)
+                return FIXED_ONE;
+            const quint32 afterPosition = positions[setNum+1];
+            if (value >= afterPosition)
+                return 0;
+            return FIXED_ONE - (((value - position) * reciprocals[setNum]) >> 16);
+        }
+    }
+
+    template <int NbSets>
+    void cocoDegreesFixed(const quint16* positions, const quint32* reciprocals, int /*nbSets*/, quint32 value, quint16* degrees)
+    {
+        for (int s = 0; s < NbSets; s++)
+            degrees[s] = cocoDegreeFixed(positions, reciprocals, NbSets - 1, value, s);
+    }
+
+    void cocoDegreesFixedGeneric(const quint16* positions, const quint32* reciprocals, int nbSets, quint32 value, quint16* degrees);
+
+    /**
+      * Compute the fire level of a rule, i.e. the AND (min) of its antecedents
+      * degrees. Missing values and rules without any antecedent give a fire level
+      * of 0 (rule dropped), like FuzzyRule::evaluate() does.
+      *
+      * @param degrees Degrees of all the input sets of the system.
+      * @param antecedents Indexes of the antecedents in the degrees array.
+      * @param nbAntecedents Number of antecedents (ignored, NbAntecedents is used instead).
+      */
+    template <int NbAntecedents>
+    double ruleFire(const double* degrees, const int* antecedents, int /*nbAntecedents*/)
+    {
+        double eval = degrees[antecedents[0]];
+        for (int i = 1; i < NbAntecedents; i++) {
+            const double d = degrees[antecedents[i]];
+            eval = (eval <= d) ? eval : d;
+        }
+        return (eval <= 1.0) ? eval : 0.0;
+    }
+
+    template <>
+    inline double ruleFire<0>(const double* /*degrees*/, const int* /*antecedents*/, int /*nbAntecedents*/)
+    {
+        return 0.0;
+    }
+
+    double ruleFireGeneric(const double* degrees, const int* antecedents, int nbAntecedents);
+
+    /**
+      * Fixed point version of ruleFire(). The degree of a missing value is masked to
+      * FIXED_ONE, so that it is ignored by the AND, and the rule is dropped when none
+      * of its antecedents has a value.
+      *
+      * @param degrees Degrees of all the input sets of the system.
+      * @param missing Masks of the input variables.
+      * @param antecedents Indexes of the antecedents in the degrees array.
+      * @param antecedentVars Variables of the antecedents.
+      * @param nbAntecedents Number of antecedents (ignored, NbAntecedents is used instead).
+      */
+    template <int NbAntecedents>
+    quint16 ruleFireFixed(const quint16* degrees, const quint16* missing, const int* antecedents,
+                          const int* antecedentVars, int /*nbAntecedents*/)
+    {
+        quint16 eval = FIXED_ONE;
+        quint16 present = 0;
+        for (int i = 0; i < NbAntecedents; i++) {
+            const quint16 mask = missing[antecedentVars[i]];
+            const quint16 d = degrees[antecedents[i]] | mask;
+            eval = (eval <= d) ? eval : d;
+            present |= ~mask;
+        }
+        return present ? eval : 0;
+    }
+
+    template <>
+    inline quint16 ruleFireFixed<0>(const quint16* /*degrees*/, const quint16* /*missing*/, const int* /*antecedents*/,
+                                    const int* /*antecedentVars*/, int /*nbAntecedents*/)
+    {
+        return 0;
+    }
+
+    quint16 ruleFireFixedGeneric(const quint16* degrees, const quint16* missing, const int* antecedents,
+                                 const int* antecedentVars, int nbAntecedents);
+
+    /**
+      * Singleton defuzzification (see DefuzzMethodSingleton::defuzzVariable()).
+      *
+      * @param evals Aggregated evaluations of the output sets.
+      * @param positions Positions of the output sets.
+      * @param nbSets Number of sets (ignored, NbSets is used instead).
+      */
+    template <int NbSets>
+    double singletonDefuzz(const double* evals, const double* positions, int /*nbSets*/)
+    {
+        double evalSum = 0.0;
+        double evalProduct = 0.0;
+        for (int i = 0; i < NbSets; i++) {
+            evalSum += evals[i];
+            evalProduct += evals[i] * positions[i];
+        }
+        if (evalSum == 0.0)
+            return 0.0;
+        return evalProduct / evalSum;
+    }
+
+    double singletonDefuzzGeneric(const double* evals, const double* positions, int nbSets);
+
+    KernelSet select(int nbInSets, int nbOutSets);
+    RuleKernel ruleKernel(int nbAntecedents);
+    RuleFixedKernel ruleFixedKernel(int nbAntecedents);
+}
+
+#endif // FUZZYKERNELS_H
@@ -75,41 +75,45 @@ FuzzyMembershipsGenome::~FuzzyMembershipsGenome()
 
 /**
   * Populate the genome by reading a bitString encoding the membership functions.
+  * Each position is read at once as a field of the bitString.
   *
   *@param bitString Bitstring to be decoded.
   *@param stringSize Size of the Bitstring.
   */
-// TODO: Cette méthode est coûteuse, on pourrait gagner en attaquant directement
-//       le bitstring lorsqu'on l'utilise. (mais ça reste plus propre)
-int FuzzyMembershipsGenome::readGenomeBitString(QBitArray *bitString, int stringSize)
+int FuzzyMembershipsGenome::readGenomeBitString(const BitString *bitString, int stringSize)
 {
     // Ensure that the bit string has the correct length
     assert(stringSize == nbInVars*nbInSets*inSetsPosCodeSize + nbOutVars*nbOutSets*outSetsPosCodeSize);
-
-    int temp = 0;
+    assert(stringSize <= bitString->size());
 
     // Decode input variables
-    for (int i = 0; i < nbInVars; i++) {
-        for (int k = 0; k < nbInSets; k++) {
-            for (int l = 0; l < inSetsPosCodeSize; l++) {
-                temp += bitString->at(i*nbInSets*inSetsPosCodeSize + k*inSetsPosCodeSize + l) << l;
-            }
-            genomeArray[i*nbInSets + k] = temp;
-            temp = 0;
-        }
+    const int nbInParams = nbInVars*nbInSets;
+    for (int i = 0; i < nbInParams; i++) {
+        genomeArray[i] = bitString->field(i*inSetsPosCodeSize, inSetsPosCodeSize);
     }
 
     // Decode output variables
-    int outBitIndex = nbInVars*nbInSets*inSetsPosCodeSize;
-    int outGenomeIndex = nbInVars*nbInSets;
-    for (int i = 0; i < nbOutVars; i++) {
-        for (int k = 0; k < nbOutSets; k++) {
-            for (int l = 0; l < outSetsPosCodeSize; l++) {
-                temp += bitString->at(outBitIndex + i*nbOutSets*outSetsPosCodeSize + k*outSetsPosCodeSize + l) << l;
-            }
-            genomeArray[outGenomeIndex + i*nbOutSets + k] = temp;
-            temp = 0;
-        }
+    const int outBitIndex = nbInParams*inSetsPosCodeSize;
+    const int nbOutParams = nbOutVars*nbOutSets;
+    for (int i = 0; i < nbOutParams; i++) {
+        genomeArray[nbInParams + i] = bitString->field(outBitIndex + i*outSetsPosCodeSize, outSetsPosCodeSize);
+    }
+    return 0;
+}
+
+/**
+  * Populate the genome by reading an integer coded genotype, one gene per
+  * position, in the order of the genome.
+  *
+  *@param genes Integer coded genotype.
+  */
+int FuzzyMembershipsGenome::readGenomeGenes(const BitString *genes)
+{
+    const int nbParams = nbInVars*nbInSets + nbOutVars*nbOutSets;
+    assert(nbParams * BitString::GENE_BITS <= genes->size());
+
+    for (int i = 0; i < nbParams; i++) {
+        genomeArray[i] = genes->gene(i);
     }
     return 0;
 }
@@ -39,7 +39,7 @@
 #define FUZZYMEMBERSHIPSGENOME_H
 
 #include <QtGlobal>
-#include <QBitArray>
+#include "bitstring.h"
 #include <QDebug>
 
 class FuzzyMembershipsGenome
@@ -49,7 +49,8 @@ public:
                            int nbOutSets, int inSetsPosCodeSize, int outSetsPosCodeSize);
     virtual ~FuzzyMembershipsGenome();
 
-    int readGenomeBitString(QBitArray *bitString, int stringSize);
+    int readGenomeBitString(const BitString *bitString, int stringSize);
+    int readGenomeGenes(const BitString *genes);
     int readGenomeIntString(quint16* intString, int stringSize);
     int getNbInSets();
     int getNbOutSets();
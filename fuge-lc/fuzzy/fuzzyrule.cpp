@@ -66,6 +66,7 @@ FuzzyRule::FuzzyRule(FuzzyVariable** inVarArray, FuzzyVariable** outVarArray, Fu
     int outVarsOrig = outVars;
 
     inVarsTab = new FuzzyVariable* [inVars];
+    inVarsIdxTab = new int[inVars];
     outVarsTab = new FuzzyVariable* [outVars];
     inVarsSetsTab = new int[inVars];
     outVarsSetsTab = new int[outVars];
@@ -97,6 +98,7 @@ FuzzyRule::FuzzyRule(FuzzyVariable** inVarArray, FuzzyVariable** outVarArray, Fu
                 inVarArray[varNum]->setUsedBySystem(true);
                 // Retrieve the variable
                 inVarsTab[pos] = inVarArray[varNum];
+                inVarsIdxTab[pos] = varNum;
                 // Retrieve the corresponding set
                 inVarsSetsTab[pos] = ruleGenome->getSetNumber(i);
                 pos++;
@@ -113,6 +115,7 @@ FuzzyRule::FuzzyRule(FuzzyVariable** inVarArray, FuzzyVariable** outVarArray, Fu
                 inVarArray[varNum]->setUsedBySystem(true);
                 // Retrieve the variable
                 inVarsTab[pos] = inVarArray[varNum];
+                inVarsIdxTab[pos] = varNum;
                 // Retrieve the corresponding set
                 inVarsSetsTab[pos] = ruleGenome->getSetNumber(i);
                 pos++;
@@ -216,6 +219,7 @@ FuzzyRule::FuzzyRule(QVector<FuzzyVariable*> inVarsVector, QVector<int> inSetsVe
     inVars = inVarsVector.size();
     outVars = outVarsVector.size();
     inVarsTab = new FuzzyVariable* [inVars];
+    inVarsIdxTab = new int[inVars];
     outVarsTab = new FuzzyVariable* [outVars];
     inVarsSetsTab = new int[inVars];
     outVarsSetsTab = new int[outVars];
@@ -225,6 +229,8 @@ FuzzyRule::FuzzyRule(QVector<FuzzyVariable*> inVarsVector, QVector<int> inSetsVe
     // Copy the vectors to the local arrays
     for (int i = 0; i < inVars; i++) {
         inVarsTab[i] = inVarsVector.at(i);
+        // The index of the variable in the system is unknown here
+        inVarsIdxTab[i] = -1;
         inVarsSetsTab[i] = inSetsVector.at(i);
     }
     for (int i = 0; i < outVars; i++) {
@@ -272,6 +278,7 @@ FuzzyRule::~FuzzyRule()
     delete[] inVarsSetsTab;
     delete[] outVarsSetsTab;
     delete[] inVarsTab;
+    delete[] inVarsIdxTab;
     delete[] outVarsTab;
     delete[] fireLevel;
     //std::cout << "TEST 2 "<< std::endl;
@@ -440,3 +447,34 @@ FuzzySet* FuzzyRule::getOutSetAtPos(int pos)
 {
     return outVarsTab[pos]->getSet(outVarsSetsTab[pos]);
 }
+
+/**
+  * Returns the index, in the system input variables array, of the input variable
+  * at the corresponding position. Returns -1 if the rule was not built from a genome.
+  *
+  * @param pos Index of the input variable in the rule.
+  */
+int FuzzyRule::getInVarIndexAtPos(int pos)
+{
+    return inVarsIdxTab[pos];
+}
+
+/**
+  * Returns the number of the input set at the corresponding position.
+  *
+  * @param pos Index of the input variable in the rule.
+  */
+int FuzzyRule::getInSetIndexAtPos(int pos)
+{
+    return inVarsSetsTab[pos];
+}
+
+/**
+  * Returns the number of the output set at the corresponding position.
+  *
+  * @param pos Index of the output variable in the rule.
+  */
+int FuzzyRule::getOutSetIndexAtPos(int pos)
+{
+    return outVarsSetsTab[pos];
+}
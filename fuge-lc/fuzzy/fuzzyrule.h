@@ -62,10 +62,14 @@ public:
     FuzzySet* getInSetAtPos(int pos);
     FuzzyVariable* getOutVarAtPos(int pos);
     FuzzySet* getOutSetAtPos(int pos);
+    int getInVarIndexAtPos(int pos);
+    int getInSetIndexAtPos(int pos);
+    int getOutSetIndexAtPos(int pos);
 
 private:
     int inVars;
     FuzzyVariable** inVarsTab;
+    int* inVarsIdxTab;
     FuzzyVariable** outVarsTab;
     int* inVarsSetsTab;
     int* outVarsSetsTab;
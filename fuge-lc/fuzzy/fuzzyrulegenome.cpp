@@ -40,6 +40,8 @@
 #include <iostream>
 #include <assert.h>
 
+#include <QVarLengthArray>
+
 #include "fuzzyrulegenome.h"
 #include "systemparameters.h"
 
@@ -130,53 +132,44 @@ int FuzzyRuleGenome::getSetNumber(int varPos)
 }
 
 /**
-  * Populate the genome by reading a bitstring.
+  * Populate the genome by reading the bits of a rule in a bitstring. The variables
+  * and sets numbers are read at once as fields of the bitstring. With fixed variables
+  * the variables numbers are not coded, the input variables are taken in order and
+  * the output variables numbers are 0.
   *
-  * @param intString intstring to be read;
-  * @param stringSize size of the bitstring to be read.
+  * @param bitString bitstring to be read.
+  * @param start index of the first bit of the rule.
+  * @param stringSize number of bits of the rule.
   */
-int FuzzyRuleGenome::readGenomeBitString(quint16* bitString, int stringSize)
+int FuzzyRuleGenome::readGenomeBitString(const BitString* bitString, int start, int stringSize)
 {
-
-    int varNum;
-    int setNum;
-    QVector<bool> usedInVarsTab(inputCount);
-    QVector<bool> usedOutVarsTab(outputCount);
-
-    SystemParameters& sysParams = SystemParameters::getInstance();
+    const bool fixedVars = SystemParameters::getInstance().getFixedVars();
+    const int inVarBits = fixedVars ? 0 : inVarCodeSize;
+    const int outVarBits = fixedVars ? 0 : outVarCodeSize;
+    QVarLengthArray<bool, 64> usedInVarsTab(inputCount);
+    QVarLengthArray<bool, 64> usedOutVarsTab(outputCount);
 
     for (int i = 0; i < inputCount; i++)
         usedInVarsTab[i] = false;
     for (int i = 0; i < outputCount; i++)
         usedOutVarsTab[i] = false;
 
-    // Ensure that the int string has the correct length according to in/out variable
-    assert(stringSize == inLimit * (inVarCodeSize+inSetCodeSize) + outputCount * (outVarCodeSize+outSetCodeSize));
+    // Ensure that the bit string has the correct length according to in/out variable
+    assert(stringSize == inLimit * (inVarBits+inSetCodeSize) + outputCount * (outVarBits+outSetCodeSize));
+    assert(start + stringSize <= bitString->size());
+
     // Retrieve the input variables and their associated sets
     for (int i = 0; i < inLimit; i++) {
-        varNum = 0;
-        setNum = 0;
+        const int varStart = start + i*(inVarBits+inSetCodeSize);
 
-        if (!sysParams.getFixedVars()) {
-            // Retrieve variable number
-            for (int k = 0; k < inVarCodeSize; k++) {
-                varNum += bitString[i*(inVarCodeSize+inSetCodeSize) + k] << k;
-            }
-            // Find a valid variable number if necessary (variable already used or index out of range)
-            // Out of range
-            if (varNum >= inputCount) {
-                // Find next available variable
-                // std::cout << "invalid var num" << std::endl;
-                genomeArray[i*2] = -1;
-            }
-            // Index valid but already used
-            else if (usedInVarsTab[varNum]) {
-             //   std::cout << "var already used, Var num = " << varNum << " i (input num) = " << i << std::endl;
+        if (!fixedVars) {
+            const int varNum = bitString->field(varStart, inVarCodeSize);
+            // Out of range or already used, the variable is removed from the rule
+            if (varNum >= inputCount || usedInVarsTab[varNum]) {
                 genomeArray[i*2] = -1;
             }
             // Valid and available
             else {
-                // Store variable number
                 genomeArray[i*2] = varNum;
                 usedInVarsTab[varNum] = true;
             }
@@ -185,64 +178,88 @@ int FuzzyRuleGenome::readGenomeBitString(quint16* bitString, int stringSize)
             genomeArray[i*2] = i;
         }
 
-        // Retrieve set number
-        for (int k = 0; k < inSetCodeSize; k++) {
-            setNum += bitString[i*(inVarCodeSize+inSetCodeSize) + inVarCodeSize + k] << k;
-        }
         // Store set number
-        genomeArray[i*2 + 1] = setNum;
+        genomeArray[i*2 + 1] = bitString->field(varStart + inVarBits, inSetCodeSize);
     }
 
-
     // Index of the first bit of the first output variable
-    int outputStart = inLimit * (inVarCodeSize+inSetCodeSize);
+    const int outputStart = start + inLimit * (inVarBits+inSetCodeSize);
 
     // Retrieve the output variables and their associated sets
     for (int i = 0; i < outputCount; i++) {
+        const int base = inLimit*2 + i*2;
+        const int varStart = outputStart + i*(outVarBits+outSetCodeSize);
+        const int varNum = (outVarBits > 0) ? (int) bitString->field(varStart, outVarBits) : 0;
 
-        varNum = 0;
-        setNum = 0;
-        
-        int base = inLimit*2 + i*2;
-
-        // Retrieve variable number
-        for (int k = 0; k < outVarCodeSize; k++) {
-            varNum += bitString[outputStart + i*(outVarCodeSize+outSetCodeSize) + k] << k;
-        }
-
-        // Find a valid variable number if necessary (variable already used or index out of range)
-        // Out of range
-        if (varNum >= outputCount) {
-            // Find next available variable
-            genomeArray[base] = -1;
-        }
-        // Index valid but already used
-        else if (usedOutVarsTab[varNum]) {
+        // Out of range or already used, the variable is removed from the rule
+        if (varNum >= outputCount || usedOutVarsTab[varNum]) {
             genomeArray[base] = -1;
         }
         // Valid and available
         else {
-            // Store variable number
             genomeArray[base] = varNum;
             usedOutVarsTab[varNum] = true;
         }
 
-        // Retrieve set number
-        for (int k = 0; k < outSetCodeSize; k++) {
-            setNum += bitString[outputStart + i*(outVarCodeSize+outSetCodeSize) + outVarCodeSize + k] << k;
-        }
-
         // Store set number
-        genomeArray[base + 1] = setNum;
+        genomeArray[base + 1] = bitString->field(varStart + outVarBits, outSetCodeSize);
     }
 
-    // DEBUG
-    /*
-    std::cout << " ------------------------------------->  Rules genome : ";
-    for (int i = 0; i < inLimit*2 + outputCount*2; i++) {
-        std::cout << "/" << genomeArray[i];
+    return 0;
+}
+
+/**
+  * Return the number of genes of a rule in an integer coded genotype : for each
+  * input variable its number (unless the variables are fixed) then its set, and
+  * the set of each output variable. The output variables are always taken in order.
+  *
+  * @param inLimit maximum number of input variables of the rule.
+  * @param outCount number of output variables.
+  */
+int FuzzyRuleGenome::getGeneCount(int inLimit, int outCount)
+{
+    const bool fixedVars = SystemParameters::getInstance().getFixedVars();
+    return inLimit * (fixedVars ? 1 : 2) + outCount;
+}
+
+/**
+  * Populate the genome by reading the genes of a rule in an integer coded
+  * genotype. The input variable number inputCount stands for no variable, the
+  * variables used more than once are removed from the rule as in a bitstring.
+  *
+  * @param genes integer coded genotype to be read.
+  * @param start index of the first gene of the rule.
+  */
+int FuzzyRuleGenome::readGenomeGenes(const BitString* genes, int start)
+{
+    const bool fixedVars = SystemParameters::getInstance().getFixedVars();
+    QVarLengthArray<bool, 64> usedInVarsTab(inputCount);
+    for (int i = 0; i < inputCount; i++)
+        usedInVarsTab[i] = false;
+
+    assert((start + getGeneCount(inLimit, outputCount)) * BitString::GENE_BITS <= genes->size());
+
+    int gene = start;
+    for (int i = 0; i < inLimit; i++) {
+        if (!fixedVars) {
+            const int varNum = genes->gene(gene++);
+            if (varNum >= inputCount || usedInVarsTab[varNum]) {
+                genomeArray[i*2] = -1;
+            }
+            else {
+                genomeArray[i*2] = varNum;
+                usedInVarsTab[varNum] = true;
+            }
+        }
+        else {
+            genomeArray[i*2] = i;
+        }
+        genomeArray[i*2 + 1] = genes->gene(gene++);
+    }
+    for (int i = 0; i < outputCount; i++) {
+        genomeArray[inLimit*2 + i*2] = i;
+        genomeArray[inLimit*2 + i*2 + 1] = genes->gene(gene++);
     }
-    std::cout << std::endl;*/
 
     return 0;
 }
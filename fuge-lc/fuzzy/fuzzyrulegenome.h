@@ -41,7 +41,7 @@
 #define FUZZYRULEGENOME_H
 
 #include <QtGlobal>
-#include <QBitArray>
+#include "bitstring.h"
 
 class FuzzyRuleGenome
 {
@@ -50,7 +50,9 @@ public:
                     int outCodeSize, int inSetCodeSize, int outSetCodeSize);
     virtual ~FuzzyRuleGenome();
 
-    int readGenomeBitString(quint16* bitString, int stringSize);
+    int readGenomeBitString(const BitString* bitString, int start, int stringSize);
+    int readGenomeGenes(const BitString* genes, int start);
+    static int getGeneCount(int inLimit, int outCount);
     int readGenomeIntString(quint16* intString, int stringSize);
     int getInputVarCount();
     int getOutputVarCount();
@@ -27,6 +27,8 @@
   * loaded before making an evaluation with the data.
   */
 
+#include <QSaveFile>
+
 #include "fuzzysystem.h"
 
 
@@ -34,6 +36,9 @@
 #define VAL_MIN 0.0
 #define DEFAULT_SET 0
 #define MAX_ADM 0.71428
+// Largest position code size for which the grid tables are used
+#define GRID_MAX_CODE_SIZE 8
+#define GRID_CELL_OUTSIDE 0xFFFE
 
 /**
   * Constructor.
@@ -59,6 +64,12 @@ FuzzySystem::FuzzySystem()
     distanceMinThreshold = 0.0;
     dontCare = 0.0;
     overLearn = 0.0;
+    kernels = FuzzyKernels::select(0, 0);
+    dataset = NULL;
+    gridNodes = 0;
+    gridEvaluation = false;
+    evaluatedSamples = 0;
+    fixedPoint = SystemParameters::getInstance().getReducedPrecision();
 }
 
 /**
@@ -67,22 +78,7 @@ FuzzySystem::FuzzySystem()
 FuzzySystem::~FuzzySystem()
 {
     // TODO : trouver un bon moyen de supprimer les règles
-    // Add variables
-    for (int i = 0; i < nbInVars; i++) {
-        for (int k = inVarArray[i]->getSetsCount() - 1 ; k > -1  ; k--) {
-            inVarArray[i]->removeSet(k);
-        }
-        delete inVarArray[i];
-    }
-    delete[] inVarArray;
-
-    for (int i = 0; i < nbOutVars; i++) {
-        for (int k = outVarArray[i]->getSetsCount() - 1 ; k > -1  ; k--) {
-            outVarArray[i]->removeSet(k);
-        }
-        delete outVarArray[i];
-    }
-    delete[] outVarArray;
+    deleteVariables();
 
     if (dataLoaded) {
         // Delete the results array
@@ -146,6 +142,9 @@ void FuzzySystem::setParameters(int nbRules, int nbVarPerRule, int nbOutVars, in
     this->inSetsPosCodeSize = inSetsPosCodeSize;
     this->outSetsPosCodeSize = outSetsPosCodeSize;
 
+    // Select the evaluation kernels matching the system shape
+    kernels = FuzzyKernels::select(nbInSets, nbOutSets);
+
     // Create an empty rules array
     rulesArray = new FuzzyRule*[nbRules];
     for (int i = 0; i < nbRules; i++)
@@ -168,20 +167,23 @@ void FuzzySystem::setParameters(int nbRules, int nbVarPerRule, int nbOutVars, in
 /**
   * Loads a dataset for the fuzzy system evaluation.
   *
-  * @param systemData Dataset
+  * @param dataset Dataset
   */
-void FuzzySystem::loadData(QList<QStringList>* systemData)
+void FuzzySystem::loadData(Dataset* dataset)
 {
     SystemParameters& sysParams = SystemParameters::getInstance();
 
     // Retrieve the system data
-    this->systemData = systemData;
+    this->dataset = dataset;
 
-    //Put list of var in a hash map
-    QStringList lstVar = systemData->at(0);
-    const int size = lstVar.size();
-    for (int i = 1; i < size; i++) {
-        hashVar[lstVar.at(i)] = i;
+    // Release the arrays of the previously loaded data
+    if (dataLoaded) {
+        for (int i = 0; i < nbOutVars; i++) {
+            delete[] results[i];
+            delete[] outMinMax[i];
+        }
+        delete[] results;
+        delete[] outMinMax;
     }
 
     //this array will contain min and max of each out
@@ -195,25 +197,33 @@ void FuzzySystem::loadData(QList<QStringList>* systemData)
 
     // No fuzzy system has been loaded from a file
     if (!(membershipsLoaded && rulesLoaded)) {
+        // The variables and universes of the previously loaded data are
+        // created again, after the rules referring to them
+        if (dataLoaded) {
+            reset();
+            deleteVariables();
+            delete[] varUniverseArray;
+            varUniverseArray = NULL;
+        }
 
         // Retrieve the number of variables (in+out)
-        nbVars = systemData->at(0).count() - 1;
+        nbVars = dataset->getNbColumns();
         nbInVars = nbVars - nbOutVars;
         sysParams.setNbInVars(nbInVars);
 
-        // Create the variables arrays from the systemData information
+        // Create the variables arrays from the dataset information
         inVarArray  = new FuzzyVariable*[nbInVars];
         outVarArray = new FuzzyVariable*[nbOutVars];
 
         for (int i = 0; i < nbInVars; i++) {
-            inVarArray[i] = new FuzzyVariable(systemData->at(0).at(i+1), coco);
+            inVarArray[i] = new FuzzyVariable(dataset->getColumnName(i), coco);
             for (int l = 0; l < nbInSets; l++) {
                 FuzzySet* fSet = new FuzzySet("MF "+QString::number(l), 0, l);
                 inVarArray[i]->addSet(fSet);
             }
         }
         for (int i = nbInVars, k = 0; i < nbInVars+nbOutVars; i++, k++) {
-            outVarArray[k] = new FuzzyVariable(systemData->at(0).at(i+1), singleton/*coco*/);
+            outVarArray[k] = new FuzzyVariable(dataset->getColumnName(i), singleton/*coco*/);
             // Set the output flag
             outVarArray[k]->setOutput(true);
             for (int l = 0; l < nbOutSets; l++) {
@@ -222,15 +232,15 @@ void FuzzySystem::loadData(QList<QStringList>* systemData)
             }
         }
 
-        // Create the results array from the systemData information
-        nbSamples = systemData->size()-1;
+        // Create the results array from the dataset information
+        nbSamples = dataset->getNbSamples();
         results = new float*[nbOutVars];
         for (int i = 0; i < nbOutVars; i++) {
             results[i] = new float [nbSamples];
         }
         for (int i = 0; i < nbOutVars; i++) {
             for (int k = 0; k < nbSamples; k++) {
-                results[i][k] = systemData->at(k+1).at(nbInVars+1 + i).toDouble();
+                results[i][k] = dataset->getValue(nbInVars + i, k);
                 if (results[i][k] < outMinMax[i][0])
                 {
                     outMinMax[i][0] = results[i][k];
@@ -249,8 +259,8 @@ void FuzzySystem::loadData(QList<QStringList>* systemData)
 
     // The fuzzy system has been loaded from a file
     else {
-        // Create the results array from the systemData information
-        nbSamples = systemData->size()-1;
+        // Create the results array from the dataset information
+        nbSamples = dataset->getNbSamples();
         results = new float*[nbOutVars];
         for (int i = 0; i < nbOutVars; i++) {
             results[i] = new float [nbSamples];
@@ -258,7 +268,7 @@ void FuzzySystem::loadData(QList<QStringList>* systemData)
 
         for (int i = 0; i < nbOutVars; i++) {
             for (int k = 0; k < nbSamples; k++) {
-                results[i][k] = systemData->at(k+1).at(systemData->at(0).count() - 1 - nbOutVars +1 + i).toDouble();
+                results[i][k] = dataset->getValue(dataset->getNbColumns() - nbOutVars + i, k);
                 if (results[i][k] < outMinMax[i][0])
                 {
                      outMinMax[i][0] = results[i][k];
@@ -272,9 +282,161 @@ void FuzzySystem::loadData(QList<QStringList>* systemData)
         }
     }
 
+    // The quantized values depend on the dataset, they are computed again when needed
+    inputFixed.clear();
+    inputFixedMin.clear();
+    inputFixedScale.clear();
+
+    loadInputCells();
+
     dataLoaded = true;
 }
 
+/**
+  * Locate each input value on the grid of positions that the memberships genome
+  * can code (see loadMembershipsGenome()). The cells never change during a run,
+  * so the degree of any set is then given by a table lookup and a linear
+  * interpolation in computeGridDegrees().
+  */
+void FuzzySystem::loadInputCells()
+{
+    gridNodes = 0;
+    gridMin.clear();
+    gridStep.clear();
+    inputCells.clear();
+    inputFractions.clear();
+
+    // Only the systems built from genomes have their sets on the grid
+    if (varUniverseArray == NULL || inSetsPosCodeSize <= 0 || inSetsPosCodeSize > GRID_MAX_CODE_SIZE)
+        return;
+
+    gridNodes = 1 << inSetsPosCodeSize;
+    gridMin.resize(nbInVars);
+    gridStep.resize(nbInVars);
+    inputCells.resize(nbInVars*nbSamples);
+    inputFractions.resize(nbInVars*nbSamples);
+
+    for (int i = 0; i < nbInVars; i++) {
+        // Same computation as in loadMembershipsGenome()
+        const float valMin = varUniverseArray[i].valMin;
+        const float step = (varUniverseArray[i].valMax - valMin) / (pow(2, inSetsPosCodeSize)-1);
+        gridMin[i] = valMin;
+        gridStep[i] = step;
+
+        const float* values = dataset->getColumn(i);
+        for (int k = 0; k < nbSamples; k++) {
+            const float value = values[k];
+            quint16 cell = GRID_CELL_OUTSIDE;
+            float fraction = 0.0;
+
+            // Row of the tables where all the sets are don't care
+            if (dataset->isMissing(i, k)) {
+                cell = 2*gridNodes;
+            }
+            else if (step > 0.0) {
+                const double gridPos = (value - valMin) / step;
+                const int node = qRound(gridPos);
+                // Exactly on a position that can be coded
+                if (node >= 0 && node < gridNodes && (float) node * step + valMin == value) {
+                    cell = 2*node;
+                }
+                else if (gridPos > 0.0 && gridPos < gridNodes - 1) {
+                    const int before = (int) gridPos;
+                    cell = 2*before + 1;
+                    fraction = qBound(0.0, gridPos - before, 1.0);
+                }
+            }
+            else if (value == valMin) {
+                cell = 0;
+            }
+            inputCells[i*nbSamples + k] = cell;
+            inputFractions[i*nbSamples + k] = fraction;
+        }
+    }
+}
+
+/**
+  * Quantize the input values on 16 bits for the reduced precision evaluation.
+  *
+  * For a system built from genomes the universe of each variable is divided in
+  * a multiple of the number of positions that can be coded by the genome, so that
+  * the sets positions fall exactly on the quantization grid. For a system loaded
+  * from a file the universe spans the positions of the sets of the variable, so
+  * that it does not depend on the samples loaded (a block of a streamed
+  * evaluation). The values outside of it are clamped to its bounds, which gives
+  * the same degrees, as the sets are flat beyond their first and last positions.
+  */
+void FuzzySystem::quantizeInputValues()
+{
+    const int nbColumns = dataset->getNbColumns();
+    inputFixed.resize(nbColumns*nbSamples);
+    inputFixedMin.resize(nbColumns);
+    inputFixedScale.resize(nbColumns);
+
+    const int maxFixed = FuzzyKernels::FIXED_MISSING_INPUT - 1;
+
+    for (int i = 0; i < nbColumns; i++) {
+        const float* values = dataset->getColumn(i);
+        float valMin = VAL_MAX;
+        float valMax = -VAL_MAX;
+        float scale = 0.0;
+
+        // Genome positions grid
+        if (varUniverseArray != NULL && i < nbVars) {
+            valMin = varUniverseArray[i].valMin;
+            valMax = varUniverseArray[i].valMax;
+            int steps = (1 << inSetsPosCodeSize) - 1;
+            if (steps <= 0 || steps > maxFixed)
+                steps = maxFixed;
+            const int unit = maxFixed / steps;
+            if (valMax > valMin)
+                scale = (float) (steps*unit) / (valMax - valMin);
+        }
+        else {
+            FuzzyVariable* fVar = getInVarByName(dataset->getColumnName(i));
+            if (fVar != NULL) {
+                for (int k = 0; k < fVar->getSetsCount(); k++) {
+                    const float position = fVar->getSet(k)->getPosition();
+                    if (position < valMin)
+                        valMin = position;
+                    if (position > valMax)
+                        valMax = position;
+                }
+            }
+            // Sets all at the same position : the values must still fall on both sides
+            if (valMax == valMin) {
+                valMin -= 1.0;
+                valMax += 1.0;
+            }
+            if (valMax > valMin)
+                scale = (float) maxFixed / (valMax - valMin);
+        }
+        inputFixedMin[i] = valMin;
+        inputFixedScale[i] = scale;
+
+        for (int k = 0; k < nbSamples; k++) {
+            if (dataset->isMissing(i, k))
+                inputFixed[i*nbSamples + k] = FuzzyKernels::FIXED_MISSING_INPUT;
+            else
+                inputFixed[i*nbSamples + k] = quantizeInput(i, values[k]);
+        }
+    }
+}
+
+/**
+  * Quantize a value of a dataset column on 16 bits.
+  *
+  * @param column Index of the column (starting at 0 with the first variable).
+  * @param value Value to be quantized.
+  */
+quint16 FuzzySystem::quantizeInput(int column, float value)
+{
+    const int maxFixed = FuzzyKernels::FIXED_MISSING_INPUT - 1;
+    const int fixedValue = qRound((value - inputFixedMin.at(column)) * inputFixedScale.at(column));
+
+    return (quint16) qBound(0, fixedValue, maxFixed);
+}
+
 /**
   * Resets completely the fuzzy system.
   */
@@ -322,6 +484,28 @@ void FuzzySystem::reset()
     }
 }
 
+/**
+  * Delete the input and output variables with their sets.
+  */
+void FuzzySystem::deleteVariables()
+{
+    for (int i = 0; i < nbInVars; i++) {
+        for (int k = inVarArray[i]->getSetsCount() - 1 ; k > -1  ; k--) {
+            inVarArray[i]->removeSet(k);
+        }
+        delete inVarArray[i];
+    }
+    delete[] inVarArray;
+
+    for (int i = 0; i < nbOutVars; i++) {
+        for (int k = outVarArray[i]->getSetsCount() - 1 ; k > -1  ; k--) {
+            outVarArray[i]->removeSet(k);
+        }
+        delete outVarArray[i];
+    }
+    delete[] outVarArray;
+}
+
 void FuzzySystem::detectVarUniverses(universeBounds* varUniArray)
 {
 
@@ -331,7 +515,7 @@ void FuzzySystem::detectVarUniverses(universeBounds* varUniArray)
 
     for (int i = 0; i < nbVars; i++) {
         for (int k = 0; k < nbSamples; k++) {
-            value = systemData->at(k+1).at(i+1).toFloat();
+            value = dataset->getValue(i, k);
             if (value <= valMin)
                 valMin = value;
             if (value >= valMax)
@@ -473,11 +657,10 @@ void FuzzySystem::updateSystemDescription()
 void FuzzySystem::loadMembershipsGenome(FuzzyMembershipsGenome* membGen)
 {
 
-    float position = 0.0;
     float step = 0.0;
     float valMin = 0.0;
 
-    QVector<float> posVector;
+    QVarLengthArray<float, 16> posVector(qMax(membGen->getNbInSets(), membGen->getNbOutSets()));
 
     // Loop through all input variables
     for (int i = 0; i  < nbInVars; i++) {
@@ -486,18 +669,15 @@ void FuzzySystem::loadMembershipsGenome(FuzzyMembershipsGenome* membGen)
         // Loop through all sets of the current variable
         for (int k = 0; k < membGen->getNbInSets(); k++) {
             // Retrieve the position encoded in the genome
-            position = ((float) membGen->getInParam(i,k) * step);
-            posVector.append(position);
+            posVector[k] = ((float) membGen->getInParam(i,k) * step);
         }
-        // Sort the vector
-        //qSort(posVector);
-        std::sort(posVector.begin(), posVector.end());
+        // Sort the positions
+        sortPositions(posVector.data(), membGen->getNbInSets());
 
         // Add the sets to the variable
-        for (int l = 0; l < posVector.size(); l++) {
-            inVarArray[i]->getSet(l)->setPosition(posVector.at(l)+valMin);
+        for (int l = 0; l < membGen->getNbInSets(); l++) {
+            inVarArray[i]->getSet(l)->setPosition(posVector[l]+valMin);
         }
-        posVector.clear();
     }
 
     // Loop through all output variables
@@ -507,23 +687,73 @@ void FuzzySystem::loadMembershipsGenome(FuzzyMembershipsGenome* membGen)
         // Loop through all sets of the current variable
         for (int k = 0; k < membGen->getNbOutSets(); k++) {
             // Retrieve the position encoded in the genome
-            position = ((float) membGen->getOutParam(i,k) * step);
-            posVector.append(position);
+            posVector[k] = ((float) membGen->getOutParam(i,k) * step);
         }
-        // Sort the vector
-        //qSort(posVector);
-        std::sort(posVector.begin(), posVector.end());
+        // Sort the positions
+        sortPositions(posVector.data(), membGen->getNbOutSets());
 
         // Add the sets to the variable
-        for (int l = 0; l < posVector.size(); l++) {
-            outVarArray[i]->getSet(l)->setPosition(posVector.at(l)+valMin);
+        for (int l = 0; l < membGen->getNbOutSets(); l++) {
+            outVarArray[i]->getSet(l)->setPosition(posVector[l]+valMin);
         }
-        posVector.clear();
     }
 
     membershipsLoaded = true;
 }
 
+/**
+  * Order two values, as an element of a sorting network.
+  */
+static inline void compareExchange(float& low, float& high)
+{
+    const float value = low;
+    low = qMin(value, high);
+    high = qMax(value, high);
+}
+
+/**
+  * Sort the positions of the sets of a variable. The variables have a few sets
+  * only, so the usual counts are sorted by sorting networks (fixed sequences of
+  * compare and exchange, without branches) and the others by insertion.
+  *
+  * @param positions Positions to be sorted in ascending order.
+  * @param count Number of positions.
+  */
+void FuzzySystem::sortPositions(float* positions, int count)
+{
+    switch (count) {
+    case 0:
+    case 1:
+        break;
+    case 2:
+        compareExchange(positions[0], positions[1]);
+        break;
+    case 3:
+        compareExchange(positions[1], positions[2]);
+        compareExchange(positions[0], positions[2]);
+        compareExchange(positions[0], positions[1]);
+        break;
+    case 4:
+        compareExchange(positions[0], positions[1]);
+        compareExchange(positions[2], positions[3]);
+        compareExchange(positions[0], positions[2]);
+        compareExchange(positions[1], positions[3]);
+        compareExchange(positions[1], positions[2]);
+        break;
+    default:
+        for (int i = 1; i < count; i++) {
+            const float position = positions[i];
+            int k = i;
+            while (k > 0 && positions[k-1] > position) {
+                positions[k] = positions[k-1];
+                k--;
+            }
+            positions[k] = position;
+        }
+        break;
+    }
+}
+
 float FuzzySystem::threshold(int outVar, float value)
 {
 
@@ -547,77 +777,362 @@ float FuzzySystem::threshold(int outVar, float value)
 int FuzzySystem::getVarInDataset(const QString name)
 {
 
-    return hashVar.value(name);
+    return dataset->getColumnIndex(name) + 1;
 }
 
-void FuzzySystem::evaluateSample(int sampleNum)
+/**
+  * Build the flattened representation of the loaded system used by evaluateSample() :
+  * set positions of the variables, antecedents and consequents of the rules as indexes
+  * in the degrees and evaluations arrays, and the kernel used for each rule.
+  */
+void FuzzySystem::compileEvaluation()
 {
+    // Input variables
+    inSetsStride = 0;
+    inVarsSetsCount.resize(nbInVars);
+    for (int i = 0; i < nbInVars; i++) {
+        inVarsSetsCount[i] = inVarArray[i]->getSetsCount();
+        if (inVarsSetsCount.at(i) > inSetsStride)
+            inSetsStride = inVarsSetsCount.at(i);
+    }
+    inPositions.resize(nbInVars*inSetsStride);
+    inDegrees.resize(nbInVars*inSetsStride);
+    inDegreesKernel = kernels.degrees;
+    usedInVars.clear();
+    usedInVarsColumns.clear();
+    for (int i = 0; i < nbInVars; i++) {
+        if (inVarArray[i]->isUsedBySystem()) {
+            const int column = dataset->getColumnIndex(inVarArray[i]->getName());
+            // Variable absent from the dataset : all its values are missing
+            if (column < 0) {
+                for (int k = 0; k < inVarsSetsCount.at(i); k++)
+                    inDegrees[i*inSetsStride + k] = FuzzyKernels::MISSING_DEGREE;
+                continue;
+            }
+            usedInVars.append(i);
+            usedInVarsColumns.append(column);
+            for (int k = 0; k < inVarsSetsCount.at(i); k++) {
+                inPositions[i*inSetsStride + k] = inVarArray[i]->getSet(k)->getPosition();
+            }
+            // Variables whose shape differs from the selected one use the generic kernel
+            if (inVarsSetsCount.at(i) != kernels.nbInSets)
+                inDegreesKernel = &FuzzyKernels::cocoDegreesGeneric;
+        }
+    }
 
-    assert(sampleNum >= 0 && sampleNum < nbSamples);
-    QVector<float> maxFiredRule(nbOutVars);
+    // Positions on the same grid as the quantized inputs
+    if (fixedPoint) {
+        if (inputFixed.isEmpty())
+            quantizeInputValues();
+        inPositionsFixed.resize(nbInVars*inSetsStride);
+        inReciprocalsFixed.fill(0, nbInVars*inSetsStride);
+        inDegreesFixed.fill(0, nbInVars*inSetsStride);
+        // The variables absent from the dataset stay missing
+        inMissingFixed.fill(FuzzyKernels::FIXED_MISSING_MASK, nbInVars);
+        inDegreesFixedKernel = kernels.degreesFixed;
+        for (int i = 0; i < usedInVars.size(); i++) {
+            const int varNum = usedInVars.at(i);
+            for (int k = 0; k < inVarsSetsCount.at(varNum); k++) {
+                inPositionsFixed[varNum*inSetsStride + k] = quantizeInput(usedInVarsColumns.at(i),
+                                                                          inPositions.at(varNum*inSetsStride + k));
+            }
+            for (int k = 0; k + 1 < inVarsSetsCount.at(varNum); k++) {
+                inReciprocalsFixed[varNum*inSetsStride + k] =
+                        FuzzyKernels::fixedReciprocal(inPositionsFixed.at(varNum*inSetsStride + k + 1) -
+                                                      inPositionsFixed.at(varNum*inSetsStride + k));
+            }
+            if (inVarsSetsCount.at(varNum) != kernels.nbInSets)
+                inDegreesFixedKernel = &FuzzyKernels::cocoDegreesFixedGeneric;
+        }
+    }
 
-    // Clean the previous evaluation values in the output variables sets
+    // Output variables
+    outSetsStride = 0;
+    outVarsSetsCount.resize(nbOutVars);
     for (int i = 0; i < nbOutVars; i++) {
-        const int setCount = outVarArray[i]->getSetsCount();
-        for (int k = 0; k < setCount; k++) {
-            outVarArray[i]->getSet(k)->clearEval();
+        outVarsSetsCount[i] = outVarArray[i]->getSetsCount();
+        if (outVarsSetsCount.at(i) > outSetsStride)
+            outSetsStride = outVarsSetsCount.at(i);
+    }
+    outPositions.resize(nbOutVars*outSetsStride);
+    outEvals.resize(nbOutVars*outSetsStride);
+    outDefuzzKernel = kernels.defuzz;
+    for (int i = 0; i < nbOutVars; i++) {
+        for (int k = 0; k < outVarsSetsCount.at(i); k++) {
+            outPositions[i*outSetsStride + k] = outVarArray[i]->getSet(k)->getPosition();
+        }
+        if (outVarsSetsCount.at(i) != kernels.nbOutSets)
+            outDefuzzKernel = &FuzzyKernels::singletonDefuzzGeneric;
+    }
+    maxFiredRule.resize(nbOutVars);
+
+    // Rules
+    ruleAntecedentsStart.resize(nbRules+1);
+    ruleConsequentsStart.resize(nbRules+1);
+    ruleKernels.resize(nbRules);
+    ruleFixedKernels.resize(nbRules);
+    ruleFireLevels.resize(nbRules);
+    ruleAntecedents.clear();
+    ruleAntecedentVars.clear();
+    ruleConsequents.clear();
+    ruleConsequentsOutVar.clear();
+    for (int i = 0; i < nbRules; i++) {
+        ruleAntecedentsStart[i] = ruleAntecedents.size();
+        ruleConsequentsStart[i] = ruleConsequents.size();
+        if (rulesArray[i] == NULL) {
+            ruleKernels[i] = FuzzyKernels::ruleKernel(0);
+            ruleFixedKernels[i] = FuzzyKernels::ruleFixedKernel(0);
+            continue;
+        }
+        const int nbInPairs = rulesArray[i]->getNbInPairs();
+        for (int k = 0; k < nbInPairs; k++) {
+            int varNum = rulesArray[i]->getInVarIndexAtPos(k);
+            // Rule not created from a genome : look for the variable
+            if (varNum < 0) {
+                for (int l = 0; l < nbInVars; l++) {
+                    if (inVarArray[l] == rulesArray[i]->getInVarAtPos(k))
+                        varNum = l;
+                }
+            }
+            ruleAntecedents.append(varNum*inSetsStride + rulesArray[i]->getInSetIndexAtPos(k));
+            ruleAntecedentVars.append(varNum);
+        }
+        ruleKernels[i] = FuzzyKernels::ruleKernel(nbInPairs);
+        ruleFixedKernels[i] = FuzzyKernels::ruleFixedKernel(nbInPairs);
+
+        const QList<int> *usedOutVars = rulesArray[i]->getUsedOutVars();
+        for (int k = 0; k < usedOutVars->size(); k++) {
+            int varNum = 0;
+            for (int l = 0; l < nbOutVars; l++) {
+                if (outVarArray[l] == rulesArray[i]->getOutVarAtPos(k))
+                    varNum = l;
+            }
+            ruleConsequents.append(varNum*outSetsStride + rulesArray[i]->getOutSetIndexAtPos(k));
+            ruleConsequentsOutVar.append(usedOutVars->at(k));
         }
-        maxFiredRule[i] = 0.0;
-        // Initialise the defuzz array values to -1
-        defuzzValues.replace(i, -1.0);
     }
+    ruleAntecedentsStart[nbRules] = ruleAntecedents.size();
+    ruleConsequentsStart[nbRules] = ruleConsequents.size();
 
-    // Set the input values
-    for (int i = 0; i < nbInVars; i++) {
-        if (inVarArray[i]->isUsedBySystem()) {
+    gridEvaluation = !fixedPoint && compileGrid();
+}
 
-            bool isOk;
-            float value = systemData->at(sampleNum+1).at(hashVar.value(inVarArray[i]->getName())).toFloat(&isOk);
+/**
+  * Build the degrees tables of the sets over the genome positions grid. For each
+  * cell of the grid (see loadInputCells()) the degree of a set is linear, it is
+  * stored as a start value and a slope over the cell.
+  *
+  * @return false if the sets of the system are not on the grid.
+  */
+bool FuzzySystem::compileGrid()
+{
+    if (gridNodes == 0)
+        return false;
+
+    // One row per cell plus one row for the missing values
+    const int gridCells = 2*gridNodes + 1;
+    gridStarts.resize(nbInVars*gridCells*inSetsStride);
+    gridSlopes.resize(nbInVars*gridCells*inSetsStride);
+    QVector<double> gridPositions(inSetsStride);
+
+    for (int i = 0; i < usedInVars.size(); i++) {
+        const int varNum = usedInVars.at(i);
+        const int nbSets = inVarsSetsCount.at(varNum);
+        const float valMin = gridMin.at(varNum);
+        const float step = gridStep.at(varNum);
+
+        // Positions expressed as grid nodes
+        for (int k = 0; k < nbSets; k++) {
+            const double position = inPositions.at(varNum*inSetsStride + k);
+            const int node = (step > 0.0) ? qRound((position - valMin) / step) : 0;
+            if (node < 0 || node >= gridNodes || (float) node * step + valMin != (float) position)
+                return false;
+            gridPositions[k] = node;
+        }
 
-            // Value is not numeric
-            if (isOk == false) {
-                //qDebug("missing value at sample num : %d, var : %d", sampleNum, i);
-                inVarArray[i]->setMissingVal(true);
-            }
-            // Value is OK
-            else {
-                inVarArray[i]->setInputValue(value);
+        for (int n = 0; n < gridNodes; n++) {
+            double* nodeStarts = gridStarts.data() + (varNum*gridCells + 2*n)*inSetsStride;
+            double* nodeSlopes = gridSlopes.data() + (varNum*gridCells + 2*n)*inSetsStride;
+            double* cellStarts = nodeStarts + inSetsStride;
+            double* cellSlopes = nodeSlopes + inSetsStride;
+            for (int k = 0; k < nbSets; k++) {
+                nodeStarts[k] = FuzzyKernels::cocoDegree(gridPositions.constData(), nbSets - 1, n, k);
+                nodeSlopes[k] = 0.0;
+                if (n == gridNodes - 1) {
+                    cellStarts[k] = nodeStarts[k];
+                    cellSlopes[k] = 0.0;
+                }
+                else {
+                    const double quarter = FuzzyKernels::cocoDegree(gridPositions.constData(), nbSets - 1, n + 0.25, k);
+                    const double threeQuarters = FuzzyKernels::cocoDegree(gridPositions.constData(), nbSets - 1, n + 0.75, k);
+                    cellSlopes[k] = 2.0 * (threeQuarters - quarter);
+                    cellStarts[k] = quarter - 0.25 * cellSlopes[k];
+                }
             }
         }
+        double* missingStarts = gridStarts.data() + (varNum*gridCells + 2*gridNodes)*inSetsStride;
+        double* missingSlopes = gridSlopes.data() + (varNum*gridCells + 2*gridNodes)*inSetsStride;
+        for (int k = 0; k < nbSets; k++) {
+            missingStarts[k] = FuzzyKernels::MISSING_DEGREE;
+            missingSlopes[k] = 0.0;
+        }
     }
+    return true;
+}
+
+/**
+  * Compute the degrees of the input sets used by the rules with the degrees kernel.
+  *
+  * @param sampleNum Number of the sample.
+  */
+void FuzzySystem::computeDegrees(int sampleNum)
+{
+    const int nbUsedInVars = usedInVars.size();
+    for (int i = 0; i < nbUsedInVars; i++) {
+        const int varNum = usedInVars.at(i);
+        double* degrees = inDegrees.data() + varNum*inSetsStride;
+
+        const int column = usedInVarsColumns.at(i);
+        const float value = dataset->getValue(column, sampleNum);
+
+        inDegreesKernel(inPositions.constData() + varNum*inSetsStride, inVarsSetsCount.at(varNum), value, degrees);
+
+        // Value is not numeric : all the sets are don't care. Columns without
+        // missing values skip the test.
+        if (dataset->columnHasMissing(column)) {
+            const bool missing = dataset->isMissing(column, sampleNum);
+            for (int k = 0; k < inVarsSetsCount.at(varNum); k++)
+                degrees[k] = missing ? FuzzyKernels::MISSING_DEGREE : degrees[k];
+        }
+    }
+}
+
+/**
+  * Compute the degrees of the input sets used by the rules from the grid tables.
+  *
+  * @param sampleNum Number of the sample.
+  */
+void FuzzySystem::computeGridDegrees(int sampleNum)
+{
+    const int gridCells = 2*gridNodes + 1;
+    const int nbUsedInVars = usedInVars.size();
+    for (int i = 0; i < nbUsedInVars; i++) {
+        const int varNum = usedInVars.at(i);
+        const int nbSets = inVarsSetsCount.at(varNum);
+        double* degrees = inDegrees.data() + varNum*inSetsStride;
+
+        const quint16 cell = inputCells.at(varNum*nbSamples + sampleNum);
+
+        if (cell == GRID_CELL_OUTSIDE) {
+            const float value = dataset->getValue(usedInVarsColumns.at(i), sampleNum);
+            inDegreesKernel(inPositions.constData() + varNum*inSetsStride, nbSets, value, degrees);
+        }
+        else {
+            const double fraction = inputFractions.at(varNum*nbSamples + sampleNum);
+            const double* starts = gridStarts.constData() + (varNum*gridCells + cell)*inSetsStride;
+            const double* slopes = gridSlopes.constData() + (varNum*gridCells + cell)*inSetsStride;
+            for (int k = 0; k < nbSets; k++)
+                degrees[k] = starts[k] + fraction * slopes[k];
+        }
+    }
+}
 
-    //Number of rule fired for this sample
-    //int nbRuleFired = 0;
-    //if nbRuleFired is 1, so ruleFired will be the number of the rule fired
-    //int ruleFired = -1;
+/**
+  * Compute the fire level of all the rules for a sample.
+  *
+  * @param sampleNum Number of the sample.
+  */
+void FuzzySystem::evaluateRules(int sampleNum)
+{
+    // Compute the degrees of all sets of the input variables used by the rules
+    if (gridEvaluation)
+        computeGridDegrees(sampleNum);
+    else
+        computeDegrees(sampleNum);
+
+    const double* degrees = inDegrees.constData();
+    const int* antecedents = ruleAntecedents.constData();
+    for (int i = 0; i < nbRules; i++) {
+        const int antecedentsStart = ruleAntecedentsStart.at(i);
+        ruleFireLevels[i] = ruleKernels.at(i)(degrees, antecedents + antecedentsStart,
+                                              ruleAntecedentsStart.at(i+1) - antecedentsStart);
+    }
+}
+
+/**
+  * Compute the fire level of all the rules for a sample in fixed point. Only the
+  * resulting fire levels are widened to double.
+  *
+  * @param sampleNum Number of the sample.
+  */
+void FuzzySystem::evaluateRulesFixed(int sampleNum)
+{
+    const int nbUsedInVars = usedInVars.size();
+    for (int i = 0; i < nbUsedInVars; i++) {
+        const int varNum = usedInVars.at(i);
+        const int column = usedInVarsColumns.at(i);
+        const quint16 value = inputFixed.at(column*nbSamples + sampleNum);
+
+        // The degrees of a missing value are left as they are, its mask hides them
+        const bool missing = (value == FuzzyKernels::FIXED_MISSING_INPUT);
+        inMissingFixed[varNum] = missing ? FuzzyKernels::FIXED_MISSING_MASK : 0;
+        if (!missing)
+            inDegreesFixedKernel(inPositionsFixed.constData() + varNum*inSetsStride, inReciprocalsFixed.constData() + varNum*inSetsStride,
+                                 inVarsSetsCount.at(varNum), value, inDegreesFixed.data() + varNum*inSetsStride);
+    }
+
+    const quint16* degrees = inDegreesFixed.constData();
+    const quint16* missing = inMissingFixed.constData();
+    const int* antecedents = ruleAntecedents.constData();
+    const int* antecedentVars = ruleAntecedentVars.constData();
+    for (int i = 0; i < nbRules; i++) {
+        const int antecedentsStart = ruleAntecedentsStart.at(i);
+        const quint16 eval = ruleFixedKernels.at(i)(degrees, missing, antecedents + antecedentsStart, antecedentVars + antecedentsStart,
+                                                    ruleAntecedentsStart.at(i+1) - antecedentsStart);
+        ruleFireLevels[i] = (double) eval / (double) FuzzyKernels::FIXED_ONE;
+    }
+}
+
+void FuzzySystem::evaluateSample(int sampleNum)
+{
+
+    assert(sampleNum >= 0 && sampleNum < nbSamples);
+
+    // Clean the previous evaluation values in the output variables sets
+    outEvals.fill(0.0);
+    for (int i = 0; i < nbOutVars; i++) {
+        maxFiredRule[i] = 0.0;
+        // Initialise the defuzz array values to -1
+        defuzzValues.replace(i, -1.0);
+    }
+
+    if (fixedPoint)
+        evaluateRulesFixed(sampleNum);
+    else
+        evaluateRules(sampleNum);
 
     //Who's the winner rule
     int winner = -1;
-    //int second = -1;
     float winnerFireLvl = 0.0;
     float secondFireLvl = 0.0;
-    //Who's the second rule, like this we can compute th distance between the winner and the second.
-    //This is usefull for the the overlearn criterra.
-    //int secondWinner = -1;
 
-    // Evaluate all rules
+    // Aggregate all rules
     for (int i = 0; i < nbRules; i++) {
-        // Evaluate the rule only if it exists
-        if (rulesArray[i] != NULL) {
-            rulesArray[i]->evaluate();
-        }
+        const double eval = ruleFireLevels.at(i);
 
         //usefull to know if the rule was fired
         float fire = 0.0;
 
-        const QList<int> *usedOutVars = rulesArray[i]->getUsedOutVars();
-        const int usedOutVarsSize = usedOutVars->size();
+        const int consequentsStart = ruleConsequentsStart.at(i);
+        const int consequentsEnd = ruleConsequentsStart.at(i+1);
+        for (int k = 0; k < consequentsEnd - consequentsStart; k++) {
+            // Aggregation
+            outEvals[ruleConsequents.at(consequentsStart + k)] += eval;
 
-        for (int k = 0; k < usedOutVarsSize; k++) {
-            float fireLvl = rulesArray[i]->getFireLevel(k);
+            const float fireLvl = eval;
 
             if (fireLvl > maxFiredRule[k]) {
-                maxFiredRule[usedOutVars->at(k)] = fireLvl;
+                maxFiredRule[ruleConsequentsOutVar.at(consequentsStart + k)] = fireLvl;
             }
 
             if ( fireLvl > 0.0 ) {
@@ -641,31 +1156,26 @@ void FuzzySystem::evaluateSample(int sampleNum)
 
         if ( fire >= 0.2 )
         {
-            arrRuleFired[i]++;
+            arrRuleFired[i] += dataset->getWeight(sampleNum);
         }
     }
 
     //Check the winner rule
     if ( ( winnerFireLvl - secondFireLvl >= 0.2 )  || ( secondFireLvl == 0.0 && winner != -1 ) )
     {
-        //arrRuleAlone[ruleFired]++;
-        arrRuleWinner[winner]++;
+        arrRuleWinner[winner] += dataset->getWeight(sampleNum);
     }
 
     // Default rule
     for (int i = 0; i < nbOutVars; i++) {
-        outVarArray[i]->getSet(defaultRulesSets.at(i))->setEval(1.0-maxFiredRule[i]);
+        outEvals[i*outSetsStride + defaultRulesSets.at(i)] += 1.0-maxFiredRule[i];
     }
 
     // Defuzz output variables and apply threshold
     for (int i = 0; i < nbOutVars; i++) {
-        defuzzValues.replace(i, outVarArray[i]->defuzz(100));
-            if (defuzzValues.at(i) == -1) {
-                std::cout << "Error : variable " << i << " defuzzification = -1 !!!" << std::endl;
-                throw;
-            }
+        defuzzValues.replace(i, outDefuzzKernel(outEvals.constData() + i*outSetsStride,
+                                                outPositions.constData() + i*outSetsStride, outVarsSetsCount.at(i)));
         threshValues.replace(i, threshold(i, defuzzValues.at(i)));
-        //qDebug("value = %f", defuzzValues.at(i));
     }
 }
 
@@ -683,14 +1193,23 @@ struct RuleInGeneralityFuzzy
     RuleInGeneralityFuzzy():_0(0),_1(0),_2(0),_3(0){}
 };
 
+/**
+  * Evaluate the fitness of the system on the whole loaded dataset.
+  */
 float FuzzySystem::evaluateFitness()
 {
+    beginEvaluation();
+    evaluateSamples();
+    return endEvaluation();
+}
 
-    CoevStats& coevStats = CoevStats::getInstance();
-    SystemParameters& sysParams = SystemParameters::getInstance();
-
-    QVector<fitnessStruct> fitVector(nbOutVars);
-
+/**
+  * Reset the fitness measurements before evaluating the samples, possibly in
+  * several blocks (see evaluateSamples()).
+  */
+void FuzzySystem::beginEvaluation()
+{
+    fitVector.resize(nbOutVars);
     for (int i = 0; i < nbOutVars; i++) {
         fitVector[i].tPosCount = 0;
         fitVector[i].tNegCount = 0;
@@ -730,13 +1249,6 @@ float FuzzySystem::evaluateFitness()
     this->dontCare = 0;
     this->overLearn = 0;
 
-    // Ensure that data, rules and memberships are loaded
-    assert(dataLoaded && rulesLoaded && membershipsLoaded);
-
-    defuzzValues.resize(nbOutVars);
-    threshValues.resize(nbOutVars);
-    computedResults.resize(nbSamples*nbOutVars);
-
     //to compute overLearn
     arrRuleFired = new int[nbRules];
     //arrRuleAlone = new int[nbRules];
@@ -752,10 +1264,36 @@ float FuzzySystem::evaluateFitness()
         //arrRuleGrade[i] = 0.0;
     }
 
+    evaluatedSamples = 0;
+}
+
+/**
+  * Evaluate all the samples of the loaded dataset and accumulate the fitness
+  * measurements. A dataset streamed by blocks is evaluated by loading each block
+  * with loadData() and calling this method, between beginEvaluation() and
+  * endEvaluation(). The defuzzified values of the block are in computedResults.
+  * The measurements of a collapsed sample are multiplied by its weight, so that
+  * they are the same as if each identical sample had been evaluated.
+  */
+void FuzzySystem::evaluateSamples()
+{
+    SystemParameters& sysParams = SystemParameters::getInstance();
+
+    // Ensure that data, rules and memberships are loaded
+    assert(dataLoaded && rulesLoaded && membershipsLoaded);
+
+    compileEvaluation();
+
+    defuzzValues.resize(nbOutVars);
+    threshValues.resize(nbOutVars);
+    computedResults.resize(nbSamples*nbOutVars);
+
     // Evaluate all samples
     for (int i = 0; i < nbSamples; i++) {
 
         evaluateSample(i);
+        // A collapsed sample counts for all the identical samples it stands for
+        const int weight = dataset->getWeight(i);
         for (int k = 0; k < nbOutVars; k++) {
             const float defuzzedValue = defuzzValues.at(k);
             computedResults.replace(i*nbOutVars + k, defuzzedValue);
@@ -764,9 +1302,9 @@ float FuzzySystem::evaluateFitness()
             const float error = defuzzedValue - results[k][i]; /* Predict - Actual */
             if (error != 0.0){
                 const float errorMoy = ( defuzzedValue + results[k][i] ) / 2.0;
-                fitVector[k].squareError += ( error / errorMoy ) * ( error / errorMoy ); /* relative square error */
-                fitVector[k].errorSum    += fabs( error ) / errorMoy;
-                fitVector[k].rmseError   += error * error;
+                fitVector[k].squareError += weight * ( error / errorMoy ) * ( error / errorMoy ); /* relative square error */
+                fitVector[k].errorSum    += weight * fabs( error ) / errorMoy;
+                fitVector[k].rmseError   += weight * error * error;
             }
 
             /* Compute classification criterra : sensi, specy, ppv, accuracy, ADM, MDM */
@@ -776,15 +1314,15 @@ float FuzzySystem::evaluateFitness()
 
 
             if (threshValueAtK == resTmp && resTmp == 0) { //well classified, below threshold
-                fitVector[k].tNegCount++;
+                fitVector[k].tNegCount += weight;
 
                 const float distThreshBelow = (thresholdAtK - defuzzedValue) / (thresholdAtK - results[k][i]);
                 //distThreshBelow = (distThreshBelow) > 1.0 ? 1.0 : distThreshBelow;// to keep the adm between 0 and 1
                 //fitVector[k].sumDistBelow += distThreshBelow * (1.0-(distThreshBelow-1.0)*(distThreshBelow-1.0)*(distThreshBelow-1.0)*(distThreshBelow-1.0));
                 if (distThreshBelow >= MAX_ADM) {
-                    fitVector[k].sumDistBelow +=  1.0;
+                    fitVector[k].sumDistBelow += weight;
                 } else {
-                    fitVector[k].sumDistBelow += distThreshBelow * ( 2.8 - ( 1.96 * distThreshBelow ) );
+                    fitVector[k].sumDistBelow += weight * distThreshBelow * ( 2.8 - ( 1.96 * distThreshBelow ) );
                 }
 
                 // Distance min to threshold from below
@@ -792,15 +1330,15 @@ float FuzzySystem::evaluateFitness()
                     fitVector[k].distMinBelow = distThreshBelow;
                 }
             } else if (threshValueAtK == resTmp && resTmp == 1) { //well classified, above threshold
-                fitVector[k].tPosCount++;
+                fitVector[k].tPosCount += weight;
 
                 const float distThreshAbove = (defuzzedValue - thresholdAtK) / (results[k][i] - thresholdAtK);
                 //distThreshAbove = (distThreshAbove) > 1.0 ? 1.0 : distThreshAbove;
                 //fitVector[k].sumDistAbove += distThreshAbove  * (1.0-(distThreshAbove-1.0)*(distThreshAbove-1.0)*(distThreshAbove-1.0)*(distThreshAbove-1.0));
                 if (distThreshAbove >= MAX_ADM) {
-                    fitVector[k].sumDistAbove +=  1.0;
+                    fitVector[k].sumDistAbove += weight;
                 } else {
-                    fitVector[k].sumDistAbove += distThreshAbove * ( 2.8 - ( 1.96 * distThreshAbove ) );
+                    fitVector[k].sumDistAbove += weight * distThreshAbove * ( 2.8 - ( 1.96 * distThreshAbove ) );
                 }
 
                 // Distance min to threshold from above
@@ -808,9 +1346,9 @@ float FuzzySystem::evaluateFitness()
                     fitVector[k].distMinAbove = distThreshAbove;
                 }
             } else if (threshValueAtK != resTmp && resTmp == 0) { //wrong classified, above threshold
-                fitVector[k].fPosCount++;   
+                fitVector[k].fPosCount += weight;   
             } else if (threshValueAtK != resTmp && resTmp == 1) { // wrong classified, below threshold
-                fitVector[k].fNegCount++;
+                fitVector[k].fNegCount += weight;
             }
 
 
@@ -857,7 +1395,17 @@ float FuzzySystem::evaluateFitness()
             }
             */
         }
+        evaluatedSamples += weight;
     }
+}
+
+/**
+  * Compute the fitness from the measurements accumulated over all the evaluated
+  * samples.
+  */
+float FuzzySystem::endEvaluation()
+{
+    SystemParameters& sysParams = SystemParameters::getInstance();
 
     // Sum values for the different outputs of each fitness parameter
     for (int l = 0; l < nbOutVars; l++) {
@@ -874,16 +1422,16 @@ float FuzzySystem::evaluateFitness()
         }
 
         //rmse
-        fitVector[l].rmse = sqrt( fitVector[l].rmseError / ( nbSamples ) );
+        fitVector[l].rmse = sqrt( fitVector[l].rmseError / ( evaluatedSamples ) );
 
         //rrse
-        fitVector[l].rrse = sqrt( fitVector[l].squareError / (double) nbSamples );
+        fitVector[l].rrse = sqrt( fitVector[l].squareError / (double) evaluatedSamples );
 
         //rae
-        fitVector[l].rae = fitVector[l].errorSum / ( double ) nbSamples;
+        fitVector[l].rae = fitVector[l].errorSum / ( double ) evaluatedSamples;
 
         //mse
-        fitVector[l].mse = fitVector[l].rmseError / ( nbSamples );
+        fitVector[l].mse = fitVector[l].rmseError / ( evaluatedSamples );
 
         //Compute mean distance to threshold ADM
         fitVector[l].distanceThreshold = ( (fitVector[l].sumDistBelow / (fitVector[l].tNegCount + fitVector[l].fPosCount))
@@ -969,7 +1517,7 @@ float FuzzySystem::evaluateFitness()
     }
 
     for( int i = 0; i < nbRules; i++ ) {
-        const float firing = (float)arrRuleFired[i] / (float)nbSamples;
+        const float firing = (float)arrRuleFired[i] / (float)evaluatedSamples;
         float winner = 0.0;
 
         if( arrRuleFired[i] != 0 ) {
@@ -1199,6 +1747,52 @@ int FuzzySystem::getDefaultRulesBitStringSize()
     return nbOutVars*outSetsCodeSize;
 }
 
+/**
+  * Return the range of each gene of an integer coded memberships genotype :
+  * the positions of the sets, in the order of the bitstring.
+  */
+QVector<quint32> FuzzySystem::getMembershipsGeneRanges()
+{
+    QVector<quint32> ranges;
+    for (int i = 0; i < nbInVars*nbInSets; i++)
+        ranges.append(1u << inSetsPosCodeSize);
+    for (int i = 0; i < nbOutVars*nbOutSets; i++)
+        ranges.append(1u << outSetsPosCodeSize);
+    return ranges;
+}
+
+/**
+  * Return the range of each gene of an integer coded rules genotype : the
+  * rules (see FuzzyRuleGenome::readGenomeGenes()) then the default set of each
+  * output variable. An input variable number may also be nbInVars, which
+  * stands for no variable, so that the rules keep a variable size.
+  */
+QVector<quint32> FuzzySystem::getRulesGeneRanges()
+{
+    const bool fixedVars = SystemParameters::getInstance().getFixedVars();
+    QVector<quint32> ranges;
+    for (int k = 0; k < nbRules; k++) {
+        for (int i = 0; i < nbVarPerRule; i++) {
+            if (!fixedVars)
+                ranges.append(nbInVars + 1);
+            ranges.append(nbInSets);
+        }
+        for (int i = 0; i < nbOutVars; i++)
+            ranges.append(nbOutSets);
+    }
+    for (int i = 0; i < nbOutVars; i++)
+        ranges.append(nbOutSets);
+    return ranges;
+}
+
+/**
+  * Return the number of genes of a rule in an integer coded rules genotype.
+  */
+int FuzzySystem::getRuleGeneCount()
+{
+    return FuzzyRuleGenome::getGeneCount(nbVarPerRule, nbOutVars);
+}
+
 QString FuzzySystem::getSystemDescritpion()
 {
     return systemDescription;
@@ -1416,13 +2010,11 @@ void FuzzySystem::saveToFile(QString fileName, float fitVal)
     defRule.appendChild(defRuleText);
     }
 
-    QString xml = doc.toString();
-    QFile file(fileName);
-    file.remove(fileName);
-    file.open(QIODevice::ReadWrite | QIODevice::Text);
-    QTextStream out(&file);
-    out << xml;
-    file.close();
+    // Written to a temporary file renamed over the previous one, so that a
+    // reader never sees a partial system
+    QSaveFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text) || file.write(doc.toByteArray()) < 0 || !file.commit())
+        std::cout << "Error : cannot write the fuzzy system " << fileName.toStdString() << std::endl;
 }
 
 int FuzzySystem::getVarIndex(QString name)
@@ -1521,6 +2113,9 @@ void FuzzySystem::loadFromFile(QString fileName)
         }
     }
 
+    // Select the evaluation kernels matching the system shape
+    kernels = FuzzyKernels::select(this->nbInSets, this->nbOutSets);
+
     // Retrieve the rules list
     nodesRules = doc.documentElement().namedItem("Rules").toElement().elementsByTagName("Rule");
     // Retrieve the number of rules and create an empty rules array
@@ -1695,7 +2290,31 @@ float FuzzySystem::getVarValMin(int varnum)
 float FuzzySystem::getVarValMax(int varnum)
 {
     assert(dataLoaded);
-    return varUniverseArray[varnum].valMin;
+    return varUniverseArray[varnum].valMax;
+}
+
+/**
+  * Replace the universes of discourse detected on the dataset, so that the genomes
+  * of a previous run are decoded into the same sets positions.
+  *
+  * @param valMins Minimum of the universe of each variable (inputs then outputs).
+  * @param valMaxs Maximum of the universe of each variable (inputs then outputs).
+  */
+void FuzzySystem::setVarUniverses(const QVector<float>& valMins, const QVector<float>& valMaxs)
+{
+    assert(dataLoaded && varUniverseArray != NULL);
+    assert(valMins.size() == nbVars && valMaxs.size() == nbVars);
+
+    for (int i = 0; i < nbVars; i++) {
+        varUniverseArray[i].valMin = valMins.at(i);
+        varUniverseArray[i].valMax = valMaxs.at(i);
+    }
+
+    // The quantized values and the grid cells depend on the universes
+    inputFixed.clear();
+    inputFixedMin.clear();
+    inputFixedScale.clear();
+    loadInputCells();
 }
 
 FuzzyRule* FuzzySystem::getRule(int ruleNum)
@@ -1742,6 +2361,8 @@ void FuzzySystem::printVerboseOutput()
     std::cout << "[ACCURACY] " << stats.getAccu() << std::endl;
     std::cout << "[PPV] " << stats.getPpv() << std::endl;
     std::cout << "[RMSE] " << stats.getRmse() << std::endl;
+    std::cout << "[ENTROPY] " << stats.getEntropyPop1() << " " << stats.getEntropyPop2() << std::endl;
+    std::cout << "[DISTANCE] " << stats.getDistancePop1() << " " << stats.getDistancePop2() << std::endl;
     std::cout << "[DESCRIPTION] " << std::endl;
     for (int i = 0; i < this->nbRules; i++) {
         std::cout << "[RULE " << i << "] " << rulesArray[i]->getDescription().toStdString() << std::endl;
@@ -1764,3 +2385,38 @@ void FuzzySystem::setFitness(float fit)
 
     this->fitness = fit;
 }
+
+/**
+  * Select the reduced precision (fixed point) evaluation.
+  *
+  * @param value True to evaluate the system in fixed point.
+  */
+void FuzzySystem::setFixedPoint(bool value)
+{
+    fixedPoint = value;
+}
+
+bool FuzzySystem::isFixedPoint()
+{
+    return fixedPoint;
+}
+
+/**
+  * Evaluate the system both in floating point and in fixed point on the loaded
+  * data and return the fitness difference (fixed point - floating point). The
+  * system is left evaluated in its current mode.
+  */
+float FuzzySystem::measureFixedPointDeviation()
+{
+    const bool currentMode = fixedPoint;
+
+    fixedPoint = !currentMode;
+    const float otherFitness = evaluateFitness();
+    fixedPoint = currentMode;
+    const float currentFitness = evaluateFitness();
+
+    if (currentMode)
+        return currentFitness - otherFitness;
+    else
+        return otherFitness - currentFitness;
+}
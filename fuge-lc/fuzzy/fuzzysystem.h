@@ -41,6 +41,7 @@
 #include <QStringList>
 #include <QVector>
 #include <QHash>
+#include <QVarLengthArray>
 #include <iostream>
 #include <QDebug>
 #include <QMutex>
@@ -55,6 +56,8 @@
 #include "fuzzyrule.h"
 #include "fuzzyrulegenome.h"
 #include "fuzzymembershipsgenome.h"
+#include "fuzzykernels.h"
+#include "dataset.h"
 
 typedef enum {truePos, trueNeg, falsePos, falseNeg} evalResult_t;
 
@@ -68,16 +71,22 @@ public:
     void setParameters(int nbRules, int nbVarPerRule, int nbOutVars, int nbInSets, int nbOutSets, int inVarsCodeSize,
                          int outVarsCodeSize, int inSetsCodeSize, int outSetsCodeSize, int inSetsPosCodeSize, int outSetsPosCodeSize);
 
-    void loadData(QList<QStringList>* systemData);
+    void loadData(Dataset* dataset);
+    Dataset* getDataset() {return dataset;}
     void loadRulesGenome(FuzzyRuleGenome** ruleGenArray, int* defaultRuleSet);
     void loadMembershipsGenome(FuzzyMembershipsGenome* membGen);
     float evaluateFitness();
     QVector<float> doEvaluateFitness();
+    void beginEvaluation();
+    void evaluateSamples();
+    float endEvaluation();
+    const QVector<float>& getComputedResults() {return computedResults;}
     void reset();
     int getNbRules();
     int getNbVarPerRule();
     int getNbInVars();
     int getNbOutVars();
+    int getNbSamples() {return nbSamples;}
     int getNbInSets();
     int getNbOutSets();
     int getInVarsCodeSize();
@@ -90,6 +99,9 @@ public:
     int getRuleBitStringSize();
     int getRuleMaxBitStringSize();
     int getDefaultRulesBitStringSize();
+    QVector<quint32> getMembershipsGeneRanges();
+    QVector<quint32> getRulesGeneRanges();
+    int getRuleGeneCount();
     void setNbInSets(int num);
     void setNbOutSets(int num);
     QString getSystemDescritpion();
@@ -121,16 +133,20 @@ public:
     FuzzyVariable* getOutVarByName(QString name);
     float getVarValMin(int varnum);
     float getVarValMax(int varnum);
+    void setVarUniverses(const QVector<float>& valMins, const QVector<float>& valMaxs);
     FuzzyRule* getRule(int ruleNum);
     void replaceRule(int ruleNum, FuzzyRule* newRule);
     QVector<int> getDefaultRules();
     void updateDefaultRule(int outVarNum,  int defaultSet);
     void printVerboseOutput();
+    void setFixedPoint(bool value);
+    bool isFixedPoint();
+    float measureFixedPointDeviation();
 
     QMutex mutex;
 
 private:
-    QList<QStringList>* systemData;
+    Dataset* dataset;
     QString systemDescription;
     FuzzyVariable** inVarArray;
     FuzzyVariable** outVarArray;
@@ -190,9 +206,72 @@ private:
     double** outMinMax;
     float maxFireLevel;
 
-    QHash<QString, int> hashVar; //var name map position of var in dataSet
+    // Reduced precision evaluation : inputs quantized on 16 bits, stored column by column
+    // (inputFixed[column*nbSamples + sample]). The evaluation only reads these ones, the
+    // float columns stay in the dataset, which may be shared by other systems or mapped
+    // from the cache, and are still read for the outputs and the floating point evaluation
+    // of measureFixedPointDeviation().
+    bool fixedPoint;
+    QVector<quint16> inputFixed;
+    QVector<float> inputFixedMin;
+    QVector<float> inputFixedScale;
 
+    // Cell of each input value on the genome positions grid (same layout as inputFixed).
+    // Cell 2*n means that the value is on the node n, cell 2*n+1 that it lies between
+    // the nodes n and n+1 at the offset given by inputFractions. Missing values are
+    // in the cell 2*gridNodes.
+    int gridNodes;
+    QVector<float> gridMin;
+    QVector<float> gridStep;
+    QVector<quint16> inputCells;
+    QVector<float> inputFractions;
+
+    // Flattened representation of the system used by evaluateSample()
+    FuzzyKernels::KernelSet kernels;
+    FuzzyKernels::DegreesKernel inDegreesKernel;
+    FuzzyKernels::DefuzzKernel outDefuzzKernel;
+    int inSetsStride;
+    int outSetsStride;
+    QVector<int> usedInVars;
+    QVector<int> usedInVarsColumns;
+    QVector<int> inVarsSetsCount;
+    QVector<int> outVarsSetsCount;
+    QVector<double> inPositions;
+    QVector<double> inDegrees;
+    QVector<double> outPositions;
+    QVector<double> outEvals;
+    QVector<float> maxFiredRule;
+    QVector<int> ruleAntecedentsStart;
+    QVector<int> ruleAntecedents;
+    QVector<FuzzyKernels::RuleKernel> ruleKernels;
+    QVector<int> ruleConsequentsStart;
+    QVector<int> ruleConsequents;
+    QVector<int> ruleConsequentsOutVar;
+    QVector<double> ruleFireLevels;
+    FuzzyKernels::DegreesFixedKernel inDegreesFixedKernel;
+    QVector<quint16> inPositionsFixed;
+    QVector<quint32> inReciprocalsFixed;
+    QVector<quint16> inDegreesFixed;
+    // Missing mask of each input variable for the current sample, and variable of each antecedent
+    QVector<quint16> inMissingFixed;
+    QVector<int> ruleAntecedentVars;
+    QVector<FuzzyKernels::RuleFixedKernel> ruleFixedKernels;
+    bool gridEvaluation;
+    QVector<double> gridStarts;
+    QVector<double> gridSlopes;
+
+    void deleteVariables();
     void detectVarUniverses(universeBounds* varUniArray);
+    static void sortPositions(float* positions, int count);
+    void loadInputCells();
+    void quantizeInputValues();
+    quint16 quantizeInput(int column, float value);
+    void compileEvaluation();
+    bool compileGrid();
+    void computeDegrees(int sampleNum);
+    void computeGridDegrees(int sampleNum);
+    void evaluateRules(int sampleNum);
+    void evaluateRulesFixed(int sampleNum);
     void evaluateSample(int sampleNum);
     int getVarIndex(QString name);
     int getVarInDataset(const QString name);
@@ -221,6 +300,10 @@ private:
         float sumDistAbove; /* used to compute MDM */
     } fitnessStruct;
 
+    // Fitness measurements accumulated by evaluateSamples()
+    QVector<fitnessStruct> fitVector;
+    int evaluatedSamples;
+
 public slots:
     void saveToFile(QString fileName, float fitness);
     void loadFromFile(QString fileName);
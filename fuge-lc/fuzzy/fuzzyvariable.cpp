@@ -37,12 +37,11 @@
 #include "defuzzmethod.h"
 #include "defuzzmethodcoa.h"
 #include "defuzzmethodsingleton.h"
+#include "fuzzyoperator.h"
 
 #include <iostream>
 #include <assert.h>
 
-#define MISSINGVAL 999.0
-
 using std::cout; using std::endl;
 
 /**
@@ -159,14 +158,15 @@ int FuzzyVariable::getSetsCount()
   */
 double FuzzyVariable::evaluateSet(const int setNum)
 {
+    // Missing value --> all the sets are dont'care
     if (this->missingVal) {
-        return MISSINGVAL;
+        return DONT_CARE_EVAL;
     }
 
     // Set number is dont'care
     // OR set number higher than existing sets --> interpreted as dont'care
     if (setNum < 0 || setNum >= memberships->getSetsCount()) {
-        return MISSINGVAL;
+        return DONT_CARE_EVAL;
     }
 
     // Compute evaluation
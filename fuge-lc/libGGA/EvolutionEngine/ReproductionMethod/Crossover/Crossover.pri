@@ -4,9 +4,13 @@ DEPENDPATH += $$PWD
 SOURCES += $$PWD/arithmetic.cpp \
     $$PWD/crossover.cpp \
     $$PWD/onepoint.cpp \
+    $$PWD/rulealigned.cpp \
+    $$PWD/twopoint.cpp \
     $$PWD/uniform.cpp
     
 HEADERS += $$PWD/arithmetic.h \
     $$PWD/crossover.h \
     $$PWD/onepoint.h \
+    $$PWD/rulealigned.h \
+    $$PWD/twopoint.h \
     $$PWD/uniform.h
@@ -2,4 +2,41 @@
 
 Crossover::Crossover()
 {
+    setGeneSize(1);
+}
+
+/**
+  * Set the number of bits of the genes which are never cut, it must divide 64.
+  */
+void Crossover::setGeneSize(int geneSize)
+{
+    Q_ASSERT(geneSize > 0 && 64 % geneSize == 0);
+    this->geneSize = geneSize;
+    geneBits = (geneSize < 64) ? (Q_UINT64_C(1) << geneSize) - 1 : ~Q_UINT64_C(0);
+    geneFirstBits = 0;
+    for(int i = 0; i < 64; i += geneSize)
+        geneFirstBits |= Q_UINT64_C(1) << i;
+}
+
+/**
+  * Exchange the bits from position from (included) to position to (excluded)
+  * of two genotypes of the same size.
+  */
+void Crossover::swapBits(BitString *first, BitString *second, int from, int to)
+{
+    if(from >= to)
+        return;
+    quint64 *firstWords = first->words();
+    quint64 *secondWords = second->words();
+    const int firstWord = from >> 6;
+    const int lastWord = (to - 1) >> 6;
+    for(int w = firstWord; w <= lastWord; w++)
+    {
+        quint64 mask = ~Q_UINT64_C(0);
+        if(w == firstWord)
+            mask &= ~Q_UINT64_C(0) << (from & 63);
+        if(w == lastWord)
+            mask &= ~Q_UINT64_C(0) >> (63 - ((to - 1) & 63));
+        swapMasked(firstWords[w], secondWords[w], mask);
+    }
 }
@@ -23,7 +23,10 @@
  * @class Crossover
  * @brief A reproduction method of two individuals
  *
- * TODO FULLDESC
+ * A crossover exchanges parts of the genotypes of the pairs of individuals,
+ * in place. The parts are exchanged by whole words, with masks. The cut
+ * points of an integer coded genotype fall between its genes only (see
+ * setGeneSize()).
  */
 
 #ifndef CROSSOVER_H
@@ -36,7 +39,38 @@ class Crossover
 {
 public:
     Crossover();
-    virtual void reproducePairOf(vector<PopEntity *> pairOfEntityList, qreal probability) = 0;
+    virtual ~Crossover() {}
+    virtual QString getName() = 0;
+    virtual void reproducePairOf(const QVector<BitString *> &pairOfGenotypes, qreal probability) = 0;
+    void setGeneSize(int geneSize);
+
+protected:
+    /**
+      * Mask of the genes of a word with at least one selected bit, in which
+      * only the first bit of each gene counts.
+      */
+    inline quint64 geneMask(quint64 selection) const
+    {
+        return (selection & geneFirstBits) * geneBits;
+    }
+
+    // Number of bits of a gene, 1 for the bit strings
+    int geneSize;
+    // First bit of each gene of a word, and mask of the bits of the first gene
+    quint64 geneFirstBits;
+    quint64 geneBits;
+
+    static void swapBits(BitString *first, BitString *second, int from, int to);
+
+    /**
+      * Exchange the bits of two words selected by a mask.
+      */
+    static inline void swapMasked(quint64 &first, quint64 &second, quint64 mask)
+    {
+        const quint64 diff = (first ^ second) & mask;
+        first ^= diff;
+        second ^= diff;
+    }
 };
 
 #endif // CROSSOVER_H
@@ -23,7 +23,7 @@
  * @class OnePoint
  * @brief A one point crossover
  *
- * TODO FULLDESC
+ * The bits after a random cut point are exchanged.
  */
 
 #ifndef ONEPOINT_H
@@ -35,7 +35,8 @@ class OnePoint : public Crossover
 {
 public:
     OnePoint();
-    void reproducePairOf(vector<PopEntity *> pairOfEntityList, qreal probability);
+    QString getName() {return "OnePoint";}
+    void reproducePairOf(const QVector<BitString *> &pairOfGenotypes, qreal probability);
 };
 
 #endif // ONEPOINT_H
@@ -0,0 +1,31 @@
+#include "rulealigned.h"
+
+RuleAligned::RuleAligned(const QVector<int> &blockStarts) : Crossover(),
+    blockStarts(blockStarts)
+{
+}
+
+void RuleAligned::reproducePairOf(const QVector<BitString *> &pairOfGenotypes, qreal probability){
+
+    for(int i = 0; i+1 < pairOfGenotypes.size(); i+=2)
+    {
+        BitString *first = pairOfGenotypes.at(i);
+        BitString *second = pairOfGenotypes.at(i+1);
+        qreal entitiyLuck = RandomGenerator::getGeneratorInstance()->randomReal(0,1);
+
+        //  if goal < chance OK.
+        if(entitiyLuck < probability){
+            quint64 choices = 0;
+            for(int k = 0; k < blockStarts.size(); k++)
+            {
+                if((k & 63) == 0)
+                    choices = RandomGenerator::getGeneratorInstance()->randomWord();
+                if((choices >> (k & 63)) & 1){
+                    const int end = (k+1 < blockStarts.size()) ? blockStarts.at(k+1) : first->size();
+                    swapBits(first, second, blockStarts.at(k), end);
+                }
+            }
+        }
+
+    }
+}
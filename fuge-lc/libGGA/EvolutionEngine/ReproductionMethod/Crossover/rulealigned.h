@@ -0,0 +1,50 @@
+/**
+ * @file rulealigned.h
+ * @author ReDS (Reconfigurable and embedded digital systems) <www.reds.ch>
+ * @author HEIG-VD (Haute école d'ingénierie et de gestion) <www.heig-vd.ch>
+ * @date 10.2026
+ * @section LICENSE
+ *
+ * This application is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * @class RuleAligned
+ * @brief A crossover exchanging whole blocks of the genotypes
+ *
+ * The genotypes are cut into blocks which are never split : the rules (and
+ * the default rules) of a rules genotype, or the membership functions of
+ * each variable of a memberships genotype. Each block is exchanged with a
+ * probability of one half, the choices of 64 blocks being given by one
+ * random word.
+ */
+
+#ifndef RULEALIGNED_H
+#define RULEALIGNED_H
+
+#include "crossover.h"
+#include "Utility/randomgenerator.h"
+
+class RuleAligned : public Crossover
+{
+public:
+    RuleAligned(const QVector<int> &blockStarts);
+    QString getName() {return "RuleAligned";}
+    void reproducePairOf(const QVector<BitString *> &pairOfGenotypes, qreal probability);
+
+private:
+    // First bit of each block, in increasing order
+    QVector<int> blockStarts;
+};
+
+#endif // RULEALIGNED_H
@@ -0,0 +1,26 @@
+#include "twopoint.h"
+
+TwoPoint::TwoPoint() : Crossover()
+{
+}
+
+void TwoPoint::reproducePairOf(const QVector<BitString *> &pairOfGenotypes, qreal probability){
+
+    for(int i = 0; i+1 < pairOfGenotypes.size(); i+=2)
+    {
+        BitString *first = pairOfGenotypes.at(i);
+        qreal entitiyLuck = RandomGenerator::getGeneratorInstance()->randomReal(0,1);
+
+        //  if goal < chance OK.
+        const int genes = first->size() / geneSize;
+        if(entitiyLuck < probability && genes > 2){
+            // Two distinct cut points, the first and the last genes are never both exchanged
+            int cutPoint1 = RandomGenerator::getGeneratorInstance()->random(1,genes-1);
+            int cutPoint2 = cutPoint1;
+            while(cutPoint2 == cutPoint1)
+                cutPoint2 = RandomGenerator::getGeneratorInstance()->random(1,genes-1);
+            swapBits(first, pairOfGenotypes.at(i+1), geneSize * qMin(cutPoint1, cutPoint2), geneSize * qMax(cutPoint1, cutPoint2));
+        }
+
+    }
+}
@@ -0,0 +1,42 @@
+/**
+ * @file twopoint.h
+ * @author ReDS (Reconfigurable and embedded digital systems) <www.reds.ch>
+ * @author HEIG-VD (Haute école d'ingénierie et de gestion) <www.heig-vd.ch>
+ * @date 10.2026
+ * @section LICENSE
+ *
+ * This application is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * @class TwoPoint
+ * @brief A two points crossover
+ *
+ * The bits between two random cut points are exchanged.
+ */
+
+#ifndef TWOPOINT_H
+#define TWOPOINT_H
+
+#include "crossover.h"
+#include "Utility/randomgenerator.h"
+
+class TwoPoint : public Crossover
+{
+public:
+    TwoPoint();
+    QString getName() {return "TwoPoint";}
+    void reproducePairOf(const QVector<BitString *> &pairOfGenotypes, qreal probability);
+};
+
+#endif // TWOPOINT_H
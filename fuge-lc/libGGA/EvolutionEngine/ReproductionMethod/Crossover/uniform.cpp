@@ -3,3 +3,21 @@
 Uniform::Uniform() : Crossover()
 {
 }
+
+void Uniform::reproducePairOf(const QVector<BitString *> &pairOfGenotypes, qreal probability){
+
+    for(int i = 0; i+1 < pairOfGenotypes.size(); i+=2)
+    {
+        qreal entitiyLuck = RandomGenerator::getGeneratorInstance()->randomReal(0,1);
+
+        //  if goal < chance OK.
+        if(entitiyLuck < probability){
+            // The unused bits of the last words are 0 in both genotypes, they stay 0
+            quint64 *first = pairOfGenotypes.at(i)->words();
+            quint64 *second = pairOfGenotypes.at(i+1)->words();
+            for(int w = 0; w < pairOfGenotypes.at(i)->wordCount(); w++)
+                swapMasked(first[w], second[w], geneMask(RandomGenerator::getGeneratorInstance()->randomWord()));
+        }
+
+    }
+}
@@ -23,18 +23,23 @@
  * @class Uniform
  * @brief A uniform crossover
  *
- * TODO FULLDESC
+ * Each bit, or each gene of an integer coded genotype, is exchanged with a
+ * probability of one half. The bits to be exchanged are given by a random
+ * word per word of the genotypes.
  */
 
 #ifndef UNIFORM_H
 #define UNIFORM_H
 
 #include "crossover.h"
+#include "Utility/randomgenerator.h"
 
 class Uniform : public Crossover
 {
 public:
     Uniform();
+    QString getName() {return "Uniform";}
+    void reproducePairOf(const QVector<BitString *> &pairOfGenotypes, qreal probability);
 };
 
 #endif // UNIFORM_H
@@ -2,7 +2,9 @@ INCLUDEPATH += $$PWD
 DEPENDPATH += $$PWD
 
 SOURCES += $$PWD/mutate.cpp \
+    $$PWD/randomresetting.cpp \
     $$PWD/toggling.cpp
 
 HEADERS += $$PWD/mutate.h \
+    $$PWD/randomresetting.h \
     $$PWD/toggling.h
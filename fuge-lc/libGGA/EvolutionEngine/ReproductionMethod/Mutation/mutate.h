@@ -37,7 +37,9 @@ class Mutate
 {
 public:
     Mutate();
-    virtual void mutateEntity(PopEntity *entity, qreal mutationPerBitProbability) = 0;
+    virtual ~Mutate() {}
+    virtual QString getName() = 0;
+    virtual void mutateEntity(BitString *genotypeData, qreal mutationPerBitProbability) = 0;
 };
 
 #endif // MUTATE_H
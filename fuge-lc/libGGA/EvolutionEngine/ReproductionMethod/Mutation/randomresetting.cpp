@@ -0,0 +1,34 @@
+#include "randomresetting.h"
+
+RandomResetting::RandomResetting(const QVector<quint32> &geneRanges) : Mutate(),
+    geneRanges(geneRanges)
+{
+}
+
+/**
+  * Replace a gene by one of the other values of its range.
+  */
+void RandomResetting::resetGene(BitString *genotypeData, int index)
+{
+    const quint32 range = geneRanges.at(index);
+    if(range < 2)
+        return;
+    quint32 value = RandomGenerator::getGeneratorInstance()->random(0, range-2);
+    if(value >= genotypeData->gene(index))
+        value++;
+    genotypeData->setGene(index, value);
+}
+
+void RandomResetting::mutateEntity(BitString *genotypeData, qreal mutationPerGeneProbability)
+{
+    Q_ASSERT(genotypeData->size() == geneRanges.size() * BitString::GENE_BITS);
+
+    if(mutationPerGeneProbability != 0){
+        for(int i = 0; i < geneRanges.size(); i++){
+            if(RandomGenerator::getGeneratorInstance()->randomReal(0,1) < mutationPerGeneProbability)
+                resetGene(genotypeData, i);
+        }
+    }else{
+        resetGene(genotypeData, RandomGenerator::getGeneratorInstance()->random(0,geneRanges.size()-1));
+    }
+}
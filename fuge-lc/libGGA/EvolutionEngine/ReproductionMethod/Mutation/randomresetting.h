@@ -0,0 +1,48 @@
+/**
+ * @file randomresetting.h
+ * @author ReDS (Reconfigurable and embedded digital systems) <www.reds.ch>
+ * @author HEIG-VD (Haute école d'ingénierie et de gestion) <www.heig-vd.ch>
+ * @date 10.2026
+ * @section LICENSE
+ *
+ * This application is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * @class RandomResetting
+ * @brief A mutation of the integer coded genotypes
+ *
+ * Each gene is replaced with the given probability by another value of its
+ * range, so that a mutated genotype is always valid.
+ */
+
+#ifndef RANDOMRESETTING_H
+#define RANDOMRESETTING_H
+
+#include "mutate.h"
+#include "randomgenerator.h"
+
+class RandomResetting : public Mutate
+{
+public:
+    RandomResetting(const QVector<quint32> &geneRanges);
+    QString getName() {return "RandomResetting";}
+    void mutateEntity(BitString *genotypeData, qreal mutationPerGeneProbability);
+
+private:
+    void resetGene(BitString *genotypeData, int index);
+
+    QVector<quint32> geneRanges;
+};
+
+#endif // RANDOMRESETTING_H
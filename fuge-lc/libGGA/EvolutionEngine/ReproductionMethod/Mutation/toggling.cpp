@@ -1,25 +1,59 @@
+#include <cmath>
+
 #include "toggling.h"
 
 Toggling::Toggling()
 {
 }
 
-void Toggling::mutateEntity(PopEntity *entity, qreal mutationPerBitProbability)
+/**
+  * Draw the number of bits kept before the next flipped bit, which follows a
+  * geometric distribution when each bit is flipped with the same probability.
+  *
+  * @param logKeep Logarithm of the probability that a bit is kept.
+  * @param limit Value returned for any gap of at least limit bits.
+  */
+static qint64 nextGap(qreal logKeep, qint64 limit)
 {
-    // TODO : DONE: Check if not too CPU consuming : Care of per bit mutation probability
-    QBitArray *genotypeData = entity->getGenotype()->getData();
+    // 1 - randomReal() lies in ]0,1], so that its logarithm is finite
+    const qreal luck = 1.0 - RandomGenerator::getGeneratorInstance()->randomReal(0,1);
+    const qreal gap = floor(log(luck) / logKeep);
+    return (gap < limit) ? (qint64) gap : limit;
+}
 
-    if(mutationPerBitProbability != 0){
-        qreal luck = 0.0;
-        for(int i=0; i < genotypeData->size(); i++){
-            luck = RandomGenerator::getGeneratorInstance()->randomReal(0,1);
-            if(luck < mutationPerBitProbability){
-                genotypeData->toggleBit(i);
-            }
-        }
-    }else{
-        quint32 togglingPos = RandomGenerator::getGeneratorInstance()->random(0,genotypeData->size()-1);
-        genotypeData->toggleBit(togglingPos);
+void Toggling::mutateEntity(BitString *genotypeData, qreal mutationPerBitProbability)
+{
+    // A rate of 0 (or below, or not a number) flips no bit
+    if(!(mutationPerBitProbability > 0))
+        return;
+
+    const qint64 size = genotypeData->size();
+    quint64 *words = genotypeData->words();
+
+    // A rate of 1 (or above) flips all the bits, without drawing any gap
+    if(mutationPerBitProbability >= 1){
+        for(qint64 w = 0; w < (size >> 6); w++)
+            words[w] = ~words[w];
+        if(size & 63)
+            words[size >> 6] ^= (Q_UINT64_C(1) << (size & 63)) - 1;
+        return;
     }
 
+    // Each bit is still flipped independently with the given probability, but
+    // only the positions of the flipped bits are drawn, and the flips of a
+    // word are applied at once.
+    const qreal logKeep = log1p(-mutationPerBitProbability);
+    qint64 word = -1;
+    quint64 flips = 0;
+    for(qint64 i = nextGap(logKeep, size); i < size; i += 1 + nextGap(logKeep, size)){
+        if((i >> 6) != word){
+            if(word >= 0)
+                words[word] ^= flips;
+            word = i >> 6;
+            flips = 0;
+        }
+        flips |= Q_UINT64_C(1) << (i & 63);
+    }
+    if(word >= 0)
+        words[word] ^= flips;
 }
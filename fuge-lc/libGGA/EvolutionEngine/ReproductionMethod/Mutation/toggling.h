@@ -9,7 +9,8 @@ class Toggling : public Mutate
 {
 public:
     Toggling();
-    void mutateEntity(PopEntity *entity, qreal mutationPerBitProbability);
+    QString getName() {return "Toggling";}
+    void mutateEntity(BitString *genotypeData, qreal mutationPerBitProbability);
 };
 
 #endif // TOGGLING_H
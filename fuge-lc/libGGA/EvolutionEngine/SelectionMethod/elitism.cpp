@@ -5,19 +5,13 @@ Elitism::Elitism() :
 {
 }
 
-inline bool entityLesserThan(PopEntity* a, PopEntity* b){
-    return a->getFitness() < b->getFitness();
-}
-
-vector<PopEntity *> Elitism::selectEntities(quint32 quantity, vector<PopEntity *> entityList)
+void Elitism::selectEntities(quint32 quantity, const QVector<qreal> &fitnesses, QVector<quint32> &selected)
 {
-    vector<PopEntity *> selectedEntities;
-    sort(entityList.begin(), entityList.end(), entityLesserThan);
+    selected.clear();
+    rankPositions(fitnesses, quantity);
 
-    for(quint32 i=entityList.size()-1; i > entityList.size()-1-quantity; i--){
-        selectedEntities.push_back(entityList.at(i));
+    for(quint32 i=0; i < quantity && i < (quint32) ranking.size(); i++){
+        selected.append(ranking.at(i));
     }
 
-    return selectedEntities;
-
 }
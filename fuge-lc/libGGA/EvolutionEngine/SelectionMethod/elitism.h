@@ -9,7 +9,8 @@ class Elitism : public EntitySelection
 {
 public:
     Elitism();
-    vector<PopEntity *> selectEntities(quint32 quantity, vector<PopEntity *> entityList);
+    void selectEntities(quint32 quantity, const QVector<qreal> &fitnesses, QVector<quint32> &selected);
+    QString getName() {return "Elitism";}
 };
 
 #endif // ELITISM_H
@@ -4,21 +4,16 @@ ElitismWithRandom::ElitismWithRandom():
     EntitySelection()
 {
 }
-inline bool entityLesserThan(PopEntity* a, PopEntity* b){
-    return a->getFitness() < b->getFitness();
-}
-vector<PopEntity *> ElitismWithRandom::selectEntities(quint32 quantity, vector<PopEntity *> entityList)
+void ElitismWithRandom::selectEntities(quint32 quantity, const QVector<qreal> &fitnesses, QVector<quint32> &selected)
 {
-    vector<PopEntity *> selectedEntities;
-    sort(entityList.begin(), entityList.end(), entityLesserThan);
+    selected.clear();
+    rankPositions(fitnesses, quantity);
 
-    for(quint32 i=entityList.size()-1; i > entityList.size()-quantity; i--){
-        selectedEntities.push_back(entityList.at(i));
+    for(quint32 i=0; i+1 < quantity && i < (quint32) ranking.size(); i++){
+        selected.append(ranking.at(i));
     }
 
-    int pos = RandomGenerator::getGeneratorInstance()->random(0,entityList.size()-1);
-    selectedEntities.push_back(entityList.at(pos));
-
-    return selectedEntities;
+    int pos = RandomGenerator::getGeneratorInstance()->random(0,fitnesses.size()-1);
+    selected.append(pos);
 
 }
@@ -7,7 +7,8 @@ class ElitismWithRandom : public EntitySelection
 {
 public:
     ElitismWithRandom();
-    vector<PopEntity *> selectEntities(quint32 quantity, vector<PopEntity *> entityList);
+    void selectEntities(quint32 quantity, const QVector<qreal> &fitnesses, QVector<quint32> &selected);
+    QString getName() {return "ElitismWithRandom";}
 };
 
 #endif // ELITISMWITHRANDOM_H
@@ -1,5 +1,39 @@
 #include "entityselection.h"
 
+// Decreasing fitness, the ties in the order of the positions
+static inline bool isBetter(const QVector<qreal> &fitnesses, quint32 a, quint32 b)
+{
+    return fitnesses.at(a) > fitnesses.at(b) || (fitnesses.at(a) == fitnesses.at(b) && a < b);
+}
+
 EntitySelection::EntitySelection()
 {
 }
+
+/**
+  * Move the count best individuals before the others, in linear time.
+  */
+void EntitySelection::partitionPositions(const QVector<qreal> &fitnesses, quint32 count)
+{
+    ranking.resize(fitnesses.size());
+    for(int i = 0; i < ranking.size(); i++)
+        ranking[i] = i;
+    if(count < (quint32) ranking.size()){
+        nth_element(ranking.begin(), ranking.begin() + count, ranking.end(), [&fitnesses](quint32 a, quint32 b) {
+            return isBetter(fitnesses, a, b);
+        });
+    }
+}
+
+/**
+  * Rank the count best individuals only, the others are just partitioned
+  * from them.
+  */
+void EntitySelection::rankPositions(const QVector<qreal> &fitnesses, quint32 count)
+{
+    partitionPositions(fitnesses, count);
+    count = qMin(count, (quint32) ranking.size());
+    sort(ranking.begin(), ranking.begin() + count, [&fitnesses](quint32 a, quint32 b) {
+        return isBetter(fitnesses, a, b);
+    });
+}
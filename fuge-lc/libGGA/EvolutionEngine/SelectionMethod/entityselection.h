@@ -4,18 +4,32 @@
 #include <vector>
 #include <Qt>
 #include <QList>
+#include <QVector>
+#include <QString>
 
 #include "popentity.h"
 #include <algorithm>
 #include "randomgenerator.h"
 
+/**
+ * A selection works on the fitnesses of a population and gives the positions
+ * of the selected individuals, the genotypes are never moved.
+ */
 class EntitySelection
 {
 public:
     EntitySelection();
-    virtual vector<PopEntity *> selectEntities(quint32 quantity, vector<PopEntity *> entityList) = 0;
-private:
+    virtual ~EntitySelection() {}
+    virtual void selectEntities(quint32 quantity, const QVector<qreal> &fitnesses, QVector<quint32> &selected) = 0;
+    virtual QString getName() = 0;
+protected:
+    void partitionPositions(const QVector<qreal> &fitnesses, quint32 count);
+    void rankPositions(const QVector<qreal> &fitnesses, quint32 count);
 
+    // Positions of the count best individuals, then of the others in no
+    // order, filled by partitionPositions() or by rankPositions() which
+    // sorts the best ones by decreasing fitness
+    QVector<quint32> ranking;
 };
 
 #endif // ENTITYSELECTION_H
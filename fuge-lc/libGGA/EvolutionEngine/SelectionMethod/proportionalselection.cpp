@@ -3,3 +3,39 @@
 ProportionalSelection::ProportionalSelection() : EntitySelection()
 {
 }
+
+void ProportionalSelection::selectEntities(quint32 quantity, const QVector<qreal> &fitnesses, QVector<quint32> &selected)
+{
+    selected.clear();
+    if(fitnesses.isEmpty() || quantity == 0)
+        return;
+
+    RandomGenerator *random = RandomGenerator::getGeneratorInstance();
+    const int n = fitnesses.size();
+    qreal total = 0.0;
+    for(int i = 0; i < n; i++)
+        total += qMax(0.0, fitnesses.at(i));
+
+    if(total > 0.0){
+        const qreal step = total / quantity;
+        qreal pointer = random->randomReal(0, step);
+        qreal cumulated = 0.0;
+        int pos = 0;
+        for(quint32 q = 0; q < quantity; q++){
+            while(pos < n - 1 && cumulated + qMax(0.0, fitnesses.at(pos)) <= pointer){
+                cumulated += qMax(0.0, fitnesses.at(pos));
+                pos++;
+            }
+            selected.append(pos);
+            pointer += step;
+        }
+    }
+    else{
+        for(quint32 q = 0; q < quantity; q++)
+            selected.append(q % n);
+    }
+
+    // The pointers visit the population in order, the pairs of the crossover must not
+    for(int i = selected.size() - 1; i > 0; i--)
+        qSwap(selected[i], selected[random->random(0, i)]);
+}
@@ -3,10 +3,18 @@
 
 #include "entityselection.h"
 
+/**
+ * Fitness proportional selection by stochastic universal sampling : the
+ * individuals are picked by equally spaced pointers on the cumulated
+ * fitnesses, so that each one is selected a number of times close to its
+ * expected one. The selected individuals are then shuffled.
+ */
 class ProportionalSelection : public EntitySelection
 {
 public:
     ProportionalSelection();
+    void selectEntities(quint32 quantity, const QVector<qreal> &fitnesses, QVector<quint32> &selected);
+    QString getName() {return "Proportional";}
 };
 
 #endif // PROPORTIONALSELECTION_H
@@ -1,34 +1,25 @@
 #include "rankbasedselection.h"
 
-RankBasedSelection::RankBasedSelection() : EntitySelection()
+RankBasedSelection::RankBasedSelection(qreal pressure) : EntitySelection(),
+    pressure(qBound(1.0, pressure, 2.0))
 {
 }
 
-vector<PopEntity *> RankBasedSelection::selectEntities(quint32 quantity, vector<PopEntity *> entityList)
+void RankBasedSelection::selectEntities(quint32 quantity, const QVector<qreal> &fitnesses, QVector<quint32> &selected)
 {
-    // THERE IS A SMALL CHANCE, that we get multiple copy of the same individual.
+    selected.clear();
+    if(fitnesses.isEmpty())
+        return;
 
-    vector<PopEntity *> selectedEntities;
-
-    PopEntity *tempEntity;
-    quint32 pos;
-    qreal bestfitness;
-    qreal fitness;
+    RandomGenerator *random = RandomGenerator::getGeneratorInstance();
+    const qint32 last = fitnesses.size() - 1;
     for(quint32 q = 0; q < quantity; q++){
-        bestfitness = 0.0;
-        for(quint32 i = 0; i < entityList.size()/10; i++){
-            pos = RandomGenerator::getGeneratorInstance()->random(0,entityList.size()-1);
-            tempEntity = entityList.at(pos);
-            fitness = tempEntity->getFitness();
-
-            if(fitness > bestfitness){
-                bestfitness = fitness;
-                tempEntity = entityList.at(pos);
-            }
+        quint32 pos = random->random(0, last);
+        if(random->randomReal(0, 1) < pressure - 1.0){
+            const quint32 other = random->random(0, last);
+            if(fitnesses.at(other) > fitnesses.at(pos))
+                pos = other;
         }
-        selectedEntities.push_back(tempEntity);
+        selected.append(pos);
     }
-
-    return selectedEntities;
-
 }
@@ -3,12 +3,23 @@
 
 #include "entityselection.h"
 
+/**
+ * Linear ranking : the probability of an individual decreases linearly with
+ * its rank, from pressure/n for the best to (2-pressure)/n for the worst.
+ * The ranks are never computed : the better of two random individuals has
+ * the linear ranking probabilities of pressure 2, which are mixed with a
+ * uniform draw to lower the pressure.
+ */
 class RankBasedSelection : public EntitySelection
 {
 public:
-    RankBasedSelection();
+    RankBasedSelection(qreal pressure = 1.5);
 
-    vector<PopEntity *> selectEntities(quint32 quantity, vector<PopEntity *> entityList);
+    void selectEntities(quint32 quantity, const QVector<qreal> &fitnesses, QVector<quint32> &selected);
+    QString getName() {return "RankBased";}
+private:
+    // Between 1 (uniform selection) and 2
+    qreal pressure;
 };
 
 #endif // RANKBASEDSELECTION_H
@@ -3,3 +3,59 @@
 RouletteWheel::RouletteWheel() : EntitySelection()
 {
 }
+
+/**
+  * Build the alias table of the fitnesses (Vose's method). The negative
+  * fitnesses count as 0, and the draw is uniform if all of them are 0.
+  */
+void RouletteWheel::buildAliasTable(const QVector<qreal> &fitnesses)
+{
+    const int n = fitnesses.size();
+    qreal total = 0.0;
+    for(int i = 0; i < n; i++)
+        total += qMax(0.0, fitnesses.at(i));
+
+    probabilities.resize(n);
+    aliases.resize(n);
+    small.clear();
+    large.clear();
+    for(int i = 0; i < n; i++){
+        // Scaled so that the mean is 1
+        probabilities[i] = (total > 0.0) ? qMax(0.0, fitnesses.at(i)) * n / total : 1.0;
+        aliases[i] = i;
+        if(probabilities.at(i) < 1.0)
+            small.append(i);
+        else
+            large.append(i);
+    }
+    while(!small.isEmpty() && !large.isEmpty()){
+        const quint32 less = small.takeLast();
+        const quint32 more = large.last();
+        aliases[less] = more;
+        probabilities[more] -= 1.0 - probabilities.at(less);
+        if(probabilities.at(more) < 1.0){
+            large.removeLast();
+            small.append(more);
+        }
+    }
+    // Left over by the rounding errors
+    for(int i = 0; i < small.size(); i++)
+        probabilities[small.at(i)] = 1.0;
+    for(int i = 0; i < large.size(); i++)
+        probabilities[large.at(i)] = 1.0;
+}
+
+void RouletteWheel::selectEntities(quint32 quantity, const QVector<qreal> &fitnesses, QVector<quint32> &selected)
+{
+    selected.clear();
+    if(fitnesses.isEmpty())
+        return;
+
+    buildAliasTable(fitnesses);
+    RandomGenerator *random = RandomGenerator::getGeneratorInstance();
+    const qint32 last = fitnesses.size() - 1;
+    for(quint32 q = 0; q < quantity; q++){
+        const quint32 pos = random->random(0, last);
+        selected.append(random->randomReal(0, 1) < probabilities.at(pos) ? pos : aliases.at(pos));
+    }
+}
@@ -3,10 +3,24 @@
 
 #include "entityselection.h"
 
+/**
+ * Fitness proportional selection. The wheel is an alias table, built in
+ * linear time, from which an individual is drawn in constant time.
+ */
 class RouletteWheel : public EntitySelection
 {
 public:
     RouletteWheel();
+    void selectEntities(quint32 quantity, const QVector<qreal> &fitnesses, QVector<quint32> &selected);
+    QString getName() {return "RouletteWheel";}
+private:
+    void buildAliasTable(const QVector<qreal> &fitnesses);
+
+    // Probability to keep the drawn position, and the position taken otherwise
+    QVector<qreal> probabilities;
+    QVector<quint32> aliases;
+    // Work lists of the positions under and over the mean probability
+    QVector<quint32> small, large;
 };
 
 #endif // ROULETTEWHEEL_H
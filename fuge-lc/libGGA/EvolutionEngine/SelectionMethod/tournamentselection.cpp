@@ -1,18 +1,32 @@
 #include "tournamentselection.h"
 
-TournamentSelection::TournamentSelection() : EntitySelection()
+TournamentSelection::TournamentSelection(quint32 tournamentSize) : EntitySelection(),
+    tournamentSize(tournamentSize)
 {
 }
 
- vector<PopEntity *> TournamentSelection::selectEntities(quint32 quantity, vector<PopEntity *> entityList)
- {
-//     uint size = entityList.size();
-//     uint pos, groupSize;
-//     for(uint popI = 0; popI < size; popI){
-//         for(uint i = 0; i < groupSize; i++)
-//         {
-//            pos = RandomGenerator::getGeneratorInstance()->random(0,size-1);
-//         }
-//     }
-     return vector<PopEntity *>();
- }
+void TournamentSelection::setTournamentSize(quint32 tournamentSize)
+{
+    this->tournamentSize = tournamentSize;
+}
+
+void TournamentSelection::selectEntities(quint32 quantity, const QVector<qreal> &fitnesses, QVector<quint32> &selected)
+{
+    // The same individual may be selected more than once
+    selected.clear();
+    if(fitnesses.isEmpty())
+        return;
+
+    RandomGenerator *random = RandomGenerator::getGeneratorInstance();
+    const qint32 last = fitnesses.size() - 1;
+    const quint32 size = (tournamentSize > 0) ? tournamentSize : qMax(1, (int) fitnesses.size()/10);
+    for(quint32 q = 0; q < quantity; q++){
+        quint32 bestPos = random->random(0, last);
+        for(quint32 i = 1; i < size; i++){
+            const quint32 pos = random->random(0, last);
+            if(fitnesses.at(pos) > fitnesses.at(bestPos))
+                bestPos = pos;
+        }
+        selected.append(bestPos);
+    }
+}
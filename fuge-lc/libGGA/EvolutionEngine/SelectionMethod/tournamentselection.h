@@ -4,11 +4,19 @@
 #include "entityselection.h"
 #include "Utility/randomgenerator.h"
 
+/**
+ * k-tournament : each selected individual is the best of k individuals
+ * drawn at random. The size 0 stands for a tenth of the population.
+ */
 class TournamentSelection : public EntitySelection
 {
 public:
-    TournamentSelection();
-     vector<PopEntity *> selectEntities(quint32 quantity, vector<PopEntity *> entityList);
+    TournamentSelection(quint32 tournamentSize = 0);
+    void selectEntities(quint32 quantity, const QVector<qreal> &fitnesses, QVector<quint32> &selected);
+    QString getName() {return "Tournament";}
+    void setTournamentSize(quint32 tournamentSize);
+private:
+    quint32 tournamentSize;
 };
 
 #endif // TOURNAMENTSELECTION_H
@@ -1,5 +1,21 @@
 #include "truncatedrankbasedselection.h"
 
-TruncatedRankBasedSelection::TruncatedRankBasedSelection() : EntitySelection()
+TruncatedRankBasedSelection::TruncatedRankBasedSelection(qreal ratio) : EntitySelection(),
+    ratio(qBound(0.0, ratio, 1.0))
 {
 }
+
+void TruncatedRankBasedSelection::selectEntities(quint32 quantity, const QVector<qreal> &fitnesses, QVector<quint32> &selected)
+{
+    selected.clear();
+    if(fitnesses.isEmpty())
+        return;
+
+    // The best ones need to be told apart from the others, not sorted
+    const qint32 kept = qMax(1, (int) (ratio * fitnesses.size()));
+    partitionPositions(fitnesses, kept);
+
+    RandomGenerator *random = RandomGenerator::getGeneratorInstance();
+    for(quint32 q = 0; q < quantity; q++)
+        selected.append(ranking.at(random->random(0, kept - 1)));
+}
@@ -3,10 +3,18 @@
 
 #include "entityselection.h"
 
+/**
+ * Truncation selection : the individuals are drawn uniformly among the
+ * given ratio of the best ones.
+ */
 class TruncatedRankBasedSelection : public EntitySelection
 {
 public:
-    TruncatedRankBasedSelection();
+    TruncatedRankBasedSelection(qreal ratio = 0.5);
+    void selectEntities(quint32 quantity, const QVector<qreal> &fitnesses, QVector<quint32> &selected);
+    QString getName() {return "TruncatedRank";}
+private:
+    qreal ratio;
 };
 
 #endif // TRUNCATEDRANKBASEDSELECTION_H
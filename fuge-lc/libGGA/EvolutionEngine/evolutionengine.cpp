@@ -2,67 +2,63 @@
 #include "../computethread.h"
 
 QMutex * EvolutionEngine::critMutex = new QMutex();
-int EvolutionEngine::state = 0;
 
 EvolutionEngine::EvolutionEngine(Population *population, quint32 generationCount, qreal crossoverProbability, qreal mutationProbability, qreal mutationPerBitProbability) :
-    population(population), generationCount(generationCount), crossoverProbability(crossoverProbability), mutationProbability(mutationProbability), mutationPerBitProbability(mutationPerBitProbability)
+    population(population), generationCount(generationCount), crossoverProbability(crossoverProbability), mutationProbability(mutationProbability), mutationPerBitProbability(mutationPerBitProbability),
+    baseCrossoverProbability(crossoverProbability), baseMutationPerBitProbability(mutationPerBitProbability), diversityTarget(0.0),
+    island(0), migrationInterval(0), migrationSize(0), randomTopology(false)
 {
     //entitySelectionMethodList.push_back(new Elitism());
     entitySelectionMethodList.push_back(new ElitismWithRandom());
+    tournamentSelection = new TournamentSelection();
+    entitySelectionMethodList.push_back(tournamentSelection);
     entitySelectionMethodList.push_back(new RankBasedSelection());
+    entitySelectionMethodList.push_back(new RouletteWheel());
+    entitySelectionMethodList.push_back(new ProportionalSelection());
+    entitySelectionMethodList.push_back(new TruncatedRankBasedSelection());
 
     crossoverMethodList.push_back(new OnePoint());
+    crossoverMethodList.push_back(new TwoPoint());
+    crossoverMethodList.push_back(new Uniform());
     mutateMethodList.push_back(new Toggling());
 }
 
-void EvolutionEngine::waitOtherThread(QMutex *access, QSemaphore *semaphore)
+/**
+  * Evolve the population. Each generation is evaluated, then its elites are
+  * published as representatives for the evaluation of the next generation of
+  * the other population, while this one is bred. The other population waits
+  * for them in evaluatePopulation(), so both populations move forward by
+  * generation with one generation of slack.
+  */
+void EvolutionEngine::startEvolution(quint32 generationCount, EntitySelection *eliteSelection, quint32 eliteSelectionCount, EntitySelection *individualsSelection, quint32 individualsSelectionCount, Mutate *mutateMethod, Crossover *crossoverMethod, quint32 cooperatorsCount)
 {
-    qDebug() << "Arrived in waiting function";
-    access->lock();
-    if (state == 0)
-    {
-        state = 1;
-        access->unlock();
-        qDebug() << "blocked in waiting function";
-        semaphore->acquire();
-    }
-    else
-    {
-        state = 0;
-        semaphore->release();
-        access->unlock();
-    }
-    qDebug() << "End of waiting function";
-}
-
-void EvolutionEngine::startEvolution(QMutex *access, QSemaphore *standby, quint32 generationCount, EntitySelection *eliteSelection, quint32 eliteSelectionCount, EntitySelection *individualsSelection, quint32 individualsSelectionCount, Mutate *mutateMethod, Crossover *crossoverMethod, quint32 cooperatorsCount)
-{
-    // TODO: crashes here when run under Qt 5 (but not under Qt 4) because leftLock and rightLock are invalid
+    RandomGenerator::setThreadGenerator(&randomGenerator);
 
     setEntitySelector(eliteSelection,eliteSelectionCount,individualsSelection,individualsSelectionCount);
 
     this->mutateMethod = mutateMethod;
     this->crossoverMethod = crossoverMethod;
 
+    // Representatives of the random population, for the first evaluation of the other one
     selectElites();
-    population->setRepresentativesCopy(selectedEntitiesCopy, cooperatorsCount);
-
-    qDebug() << population->getName() << " Before join";
+    population->publishRepresentatives(elitePositions, cooperatorsCount);
 
-    // JOIN both evolution
-    waitOtherThread(access, standby);
+    for(quint32 i = 0; i <= generationCount; i++)
+    {
+        // Evaluate population
+        if(!evaluatePopulation(population, i))
+            break;
+        if(i == generationCount)
+            break;
 
-    qDebug() << population->getName() << " AFTER join";
-    if(!evaluatePopulation(population, 0))
-        return;
+        adaptRates();
+        migrate(i, generationCount);
 
-    for(quint32 i = 1; i <= generationCount; i++)
-    {
         // Select elites from the population
         selectElites();
 
         // Set cooperators
-        population->setRepresentativesCopy(selectedEntitiesCopy, cooperatorsCount);
+        population->publishRepresentatives(elitePositions, cooperatorsCount);
 
         // Select non elite individuals
         selectIndividuals();
@@ -72,22 +68,70 @@ void EvolutionEngine::startEvolution(QMutex *access, QSemaphore *standby, quint3
 
         // Mutate
         mutate();
-        population->replace(selectedEntitiesCopy, evolvingEntitiesCopy);
 
-        // Evaluate population
-        //if(!evaluatePopulation(population, i))
-            //break;
+        // The offspring and the elites become the current generation
+        replaceGeneration();
+    }
 
+    // The other population and islands may wait for representatives and migrants which will not come
+    population->closeRepresentatives();
+    population->closeMigrants();
+    RandomGenerator::setThreadGenerator(NULL);
+    qDebug() << population->getName() << " End of evolution";
+}
 
-    }
-    if(!evaluatePopulation(population, 0))
-        return;
+/**
+  * Evolve the population one pair of children at a time. Each child is
+  * evaluated and replaces the worst individual at once. The elites are
+  * published again, and the statistics built, after each batch of
+  * individualsSelectionCount children, which counts as a generation. The
+  * children are evaluated with the last representatives the other population
+  * has published, or in lockstep with the ones it published for the same
+  * batch, so that the result does not depend on the scheduling of the threads.
+  */
+void EvolutionEngine::startSteadyStateEvolution(quint32 generationCount, EntitySelection *eliteSelection, quint32 eliteSelectionCount, EntitySelection *individualsSelection, quint32 individualsSelectionCount, Mutate *mutateMethod, Crossover *crossoverMethod, quint32 cooperatorsCount)
+{
+    RandomGenerator::setThreadGenerator(&randomGenerator);
 
-    qDebug() << population->getName() << " Before LAST join";
-    // Join and leave
-    waitOtherThread(access, standby);
+    setEntitySelector(eliteSelection,eliteSelectionCount,individualsSelection,individualsSelectionCount);
 
-    qDebug() << population->getName() << " AFTER LAST join";
+    this->mutateMethod = mutateMethod;
+    this->crossoverMethod = crossoverMethod;
+
+    selectElites();
+    population->publishRepresentatives(elitePositions, cooperatorsCount);
+
+    // The rows of the next generation are only used to breed the children
+    const quint32 childrenCount = qMax(individualsSelectionCount, (quint32) 1);
+    bool running = population->getSize() >= 2 && evaluatePopulation(population, 0);
+    for(quint32 i = 1; running && i <= generationCount; i++)
+    {
+        selectElites();
+        population->publishRepresentatives(elitePositions, cooperatorsCount);
+
+        for(quint32 children = 0; running && children < childrenCount; children += qMax((int) evolvingGenotypes.size(), 1))
+        {
+            selectParents();
+            crossover();
+            mutate();
+            for(int k = 0; k < evolvingGenotypes.size(); k++)
+                replaceWorst(evolvingGenotypes.at(k), evaluateEntity(evolvingGenotypes.at(k), i));
+            running = !ComputeThread::stop;
+        }
+
+        for(quint32 k = 0; k < population->getSize(); k++)
+            statsEngine.addFitness(population->getFitnessAt(k));
+        running = endGeneration(population, i) && running;
+        if(running && i < generationCount){
+            adaptRates();
+            migrate(i, generationCount);
+        }
+    }
+
+    population->closeRepresentatives();
+    population->closeMigrants();
+    RandomGenerator::setThreadGenerator(NULL);
+    qDebug() << population->getName() << " End of evolution";
 }
 
 void EvolutionEngine::setEntitySelector(EntitySelection *eliteSelection, quint32 eliteSelectionCount, EntitySelection *entitySelection, quint32 selectionCount)
@@ -106,6 +150,41 @@ void EvolutionEngine::setCrossoverMethod(Crossover * crossoverMethod)
 {
     this->crossoverMethod = crossoverMethod;
 }
+/**
+  * Set the stream the evolution draws from, whichever thread runs it.
+  */
+void EvolutionEngine::setRandomGenerator(const RandomGenerator &randomGenerator)
+{
+    this->randomGenerator = randomGenerator;
+}
+
+/**
+  * Exchange individuals with the populations of the same role of the other
+  * islands. Every migrationInterval generations, the migrationSize best
+  * individuals are sent to the next island (or to a random one) and the
+  * migrants sent by the other islands at the previous migration replace the
+  * worst individuals.
+  */
+void EvolutionEngine::setMigration(const QVector<Population *> &islandPopulations, quint32 island, quint32 migrationInterval, quint32 migrationSize, bool randomTopology)
+{
+    Q_ASSERT(island < (quint32) islandPopulations.size());
+    this->islandPopulations = islandPopulations;
+    this->island = island;
+    this->migrationInterval = migrationInterval;
+    this->migrationSize = migrationSize;
+    this->randomTopology = randomTopology;
+}
+
+/**
+  * Adapt the mutation and crossover rates to the diversity of the population,
+  * measured by the mean distance between its genotypes, 0 to keep the rates.
+  */
+void EvolutionEngine::setDiversityTarget(qreal diversityTarget)
+{
+    this->diversityTarget = diversityTarget;
+    crossoverProbability = baseCrossoverProbability;
+    mutationPerBitProbability = baseMutationPerBitProbability;
+}
 
 Population *EvolutionEngine::getPopulation(){
     return population;
@@ -118,6 +197,24 @@ vector<EntitySelection *> EvolutionEngine::getEntitySelectors()
         availableSelection.push_back(entitySelectionMethodList.at(i));
     return availableSelection;
 }
+/**
+  * Return the available selection with the given name, NULL if there is none.
+  */
+EntitySelection *EvolutionEngine::getEntitySelector(const QString &name)
+{
+    for(quint32 i=0; i < entitySelectionMethodList.size(); i++){
+        if(entitySelectionMethodList.at(i)->getName().compare(name, Qt::CaseInsensitive) == 0)
+            return entitySelectionMethodList.at(i);
+    }
+    return NULL;
+}
+/**
+  * Set the number of individuals of a tournament, 0 for a tenth of the population.
+  */
+void EvolutionEngine::setTournamentSize(quint32 tournamentSize)
+{
+    tournamentSelection->setTournamentSize(tournamentSize);
+}
 vector<Mutate *> EvolutionEngine::getMutationMethods()
 {
     vector<Mutate *> availableMutation;
@@ -133,6 +230,40 @@ vector<Crossover *> EvolutionEngine::getCrossoverMethods()
     return availableCrossover;
 }
 
+/**
+  * Return the available crossover with the given name, NULL if there is none.
+  */
+Crossover *EvolutionEngine::getCrossoverMethod(const QString &name)
+{
+    for(quint32 i=0; i < crossoverMethodList.size(); i++){
+        if(crossoverMethodList.at(i)->getName().compare(name, Qt::CaseInsensitive) == 0)
+            return crossoverMethodList.at(i);
+    }
+    return NULL;
+}
+
+void EvolutionEngine::addCrossoverMethod(Crossover *crossoverMethod)
+{
+    crossoverMethodList.push_back(crossoverMethod);
+}
+
+/**
+  * Return the available mutation with the given name, NULL if there is none.
+  */
+Mutate *EvolutionEngine::getMutationMethod(const QString &name)
+{
+    for(quint32 i=0; i < mutateMethodList.size(); i++){
+        if(mutateMethodList.at(i)->getName().compare(name, Qt::CaseInsensitive) == 0)
+            return mutateMethodList.at(i);
+    }
+    return NULL;
+}
+
+void EvolutionEngine::addMutationMethod(Mutate *mutateMethod)
+{
+    mutateMethodList.push_back(mutateMethod);
+}
+
 // Private :
 void EvolutionEngine::initializePopulation()
 {
@@ -140,49 +271,157 @@ void EvolutionEngine::initializePopulation()
 }
 void EvolutionEngine::selectElites()
 {
-//    for(int i = 0; i < selectedEntitiesCopy.size(); i++)
-//        delete selectedEntitiesCopy[i];
-    selectedEntitiesCopy.clear();
-    selectedEntitiesCopy = population->getSomeEntityCopy(eliteSelection,eliteSelectionCount);
-
+    eliteSelection->selectEntities(eliteSelectionCount, population->getFitnesses(), elitePositions);
 }
 
-bool EvolutionEngine::isElite(Genotype *genotype)
+bool EvolutionEngine::isElite(const BitString *genotypeData)
 {
-    for(quint32 i=0; i < selectedEntitiesCopy.size(); i++){
-        if(genotype->getData()->operator ==(*selectedEntitiesCopy.at(i)->getGenotype()->getData()))
+    for(int i=0; i < elitePositions.size(); i++){
+        if(*genotypeData == *population->genotypeAt(elitePositions.at(i)))
             return true;
     }
     return false;
 }
 
+/**
+  * Select the individuals to be reproduced and copy them to the first rows of
+  * the next generation, where they are crossed and mutated in place.
+  */
 void EvolutionEngine::selectIndividuals()
 {
-//    for(uint i = 0; i < evolvingEntitiesCopy.size(); i++)
-//        delete evolvingEntitiesCopy[i];
-    evolvingEntitiesCopy.clear();
-    evolvingEntitiesCopy = population->getSomeEntityCopy(individualsSelection,individualsSelectionCount);
+    individualsSelection->selectEntities(individualsSelectionCount, population->getFitnesses(), evolvingPositions);
+
+    const int count = qMin((int) evolvingPositions.size(), (int) population->getSize());
+    evolvingGenotypes.resize(count);
+    for(int i = 0; i < count; i++){
+        population->copyToOffspring(evolvingPositions.at(i), i);
+        evolvingGenotypes[i] = population->offspringAt(i);
+    }
 }
 void EvolutionEngine::crossover()
 {
     // Missing probability
     // Random list before crossover (To do if better results and not too processing time consuming)
-    crossoverMethod->reproducePairOf(evolvingEntitiesCopy, crossoverProbability);
+    crossoverMethod->reproducePairOf(evolvingGenotypes, crossoverProbability);
 }
 void EvolutionEngine::mutate()
 {
-
-    vector<PopEntity *>::iterator it;
-    for(it=evolvingEntitiesCopy.begin(); it!=evolvingEntitiesCopy.end(); it++)
+    for(int i = 0; i < evolvingGenotypes.size(); i++)
     {
         qreal entitiyLuck = RandomGenerator::getGeneratorInstance()->randomReal(0,1);
         //  if goal < chance OK.
         if(entitiyLuck < mutationProbability){
-            mutateMethod->mutateEntity(*it, mutationPerBitProbability);
+            mutateMethod->mutateEntity(evolvingGenotypes.at(i), mutationPerBitProbability);
         }
     }
 }
 
+/**
+  * Copy the elites after the offspring in the next generation, then make it
+  * the current one. The elites positions follow them to their new rows.
+  */
+void EvolutionEngine::replaceGeneration()
+{
+    const int first = evolvingGenotypes.size();
+    const int count = qMin((int) elitePositions.size(), (int) population->getSize() - first);
+    Q_ASSERT(first + count == (int) population->getSize());
+    for(int i = 0; i < count; i++){
+        population->copyToOffspring(elitePositions.at(i), first + i);
+        elitePositions[i] = first + i;
+    }
+    elitePositions.resize(count);
+    population->commitGeneration();
+}
+
+/**
+  * Select the two parents of the next children and copy them to the first
+  * rows of the next generation, where they are crossed and mutated in place.
+  */
+void EvolutionEngine::selectParents()
+{
+    individualsSelection->selectEntities(2, population->getFitnesses(), evolvingPositions);
+
+    const int count = qMin((int) evolvingPositions.size(), 2);
+    evolvingGenotypes.resize(count);
+    for(int i = 0; i < count; i++){
+        population->copyToOffspring(evolvingPositions.at(i), i);
+        evolvingGenotypes[i] = population->offspringAt(i);
+    }
+}
+
+/**
+  * Replace the worst individual of the current generation with a child. The
+  * other population only reads the published representatives, so the
+  * individuals are not locked.
+  */
+void EvolutionEngine::replaceWorst(const BitString *genotypeData, qreal fitness)
+{
+    const QVector<qreal> &fitnesses = population->getFitnesses();
+    quint32 worst = 0;
+    for(quint32 i = 1; i < population->getSize(); i++){
+        if(fitnesses.at(i) < fitnesses.at(worst))
+            worst = i;
+    }
+    *population->genotypeAt(worst) = *genotypeData;
+    population->setFitnessAt(worst, fitness);
+}
+
+/**
+  * Scale the rates by the ratio of the diversity target to the diversity of
+  * the last evaluated generation. Below the target, the mutation per bit is
+  * raised up to 4 times its rate and the crossover lowered down to half of
+  * its rate, to explore again before the population converges. Above it,
+  * the mutation is lowered down to half of its rate, to exploit.
+  */
+void EvolutionEngine::adaptRates()
+{
+    if(diversityTarget <= 0.0)
+        return;
+
+    const qreal diversity = statsEngine.getPairDistance();
+    const qreal ratio = (diversity > 0.0) ? diversityTarget / diversity : 4.0;
+    mutationPerBitProbability = qMin(baseMutationPerBitProbability * qBound((qreal) 0.5, ratio, (qreal) 4.0), qMax(baseMutationPerBitProbability, (qreal) 0.5));
+    crossoverProbability = baseCrossoverProbability * qBound((qreal) 0.5, 1.0 / ratio, (qreal) 1.0);
+}
+
+/**
+  * Migrate at every migrationInterval generations, the first migration being
+  * at generation migrationInterval. The migrants of an evaluated generation
+  * are sent, unless no later migration of the run would take them, then the
+  * migrants the other islands sent at the previous migration replace the
+  * worst individuals. Waiting for these ones, rather than taking the migrants
+  * arrived meanwhile, keeps the run independent of the scheduling of the
+  * threads, while an island only waits for the islands a migration behind.
+  */
+void EvolutionEngine::migrate(quint32 generation, quint32 generationCount)
+{
+    const int islandCount = islandPopulations.size();
+    if(islandCount < 2 || migrationInterval == 0 || migrationSize == 0 || generation == 0 || generation % migrationInterval != 0)
+        return;
+
+    // Numbered from 1, 0 being never sent
+    const quint64 migration = generation / migrationInterval;
+    if(generation + migrationInterval < generationCount){
+        int destination = (island + 1) % islandCount;
+        if(randomTopology){
+            destination = RandomGenerator::getGeneratorInstance()->random(0, islandCount - 2);
+            if(destination >= (int) island)
+                destination++;
+        }
+        migrantSelection.selectEntities(migrationSize, population->getFitnesses(), migrantPositions);
+        population->sendMigrants(migrantPositions, migrationSize, migration, destination);
+    }
+
+    // Taken in the order of the islands
+    for(int source = 0; migration >= 2 && source < islandCount; source++){
+        if(source == (int) island)
+            continue;
+        shared_ptr<const RepresentativeSet> migrants = islandPopulations.at(source)->waitMigrants(migration - 1, island);
+        for(int i = 0; migrants && i < migrants->getSize(); i++)
+            replaceWorst(migrants->genotypeAt(i), migrants->getFitnessAt(i));
+    }
+}
+
 StatisticEngine *EvolutionEngine::getStatisticEngine(){
     return &statsEngine;
 }
@@ -3,17 +3,25 @@
 
 #include <vector>
 #include <QThread>
+#include <QMutex>
 #include <QSemaphore>
 
 #include "population.h"
 #include "crossover.h"
 #include "onepoint.h"
+#include "twopoint.h"
+#include "uniform.h"
 #include "mutate.h"
 #include "toggling.h"
+#include "randomresetting.h"
 #include "entityselection.h"
 #include "elitism.h"
 #include "elitismwithrandom.h"
 #include "rankbasedselection.h"
+#include "tournamentselection.h"
+#include "roulettewheel.h"
+#include "proportionalselection.h"
+#include "truncatedrankbasedselection.h"
 #include "statisticengine.h"
 
 class EvolutionEngine
@@ -21,32 +29,49 @@ class EvolutionEngine
 public:
     EvolutionEngine(Population *population, quint32 generationCount, qreal crossoverProbability, qreal mutationProbability, qreal mutationPerBitProbability);
     virtual bool evaluatePopulation(Population* population, quint32 generation) = 0;
-    void startEvolution(QMutex *access,
-                                            QSemaphore *standby,
-                                            quint32 generationCount,
+    virtual qreal evaluateEntity(const BitString *genotypeData, quint32 generation) = 0;
+    virtual bool endGeneration(Population* population, quint32 generation) = 0;
+    void startEvolution(quint32 generationCount,
                                             EntitySelection *eliteSelection,
                                             quint32 eliteSelectionCount,
                                             EntitySelection *individualsSelection,
                                             quint32 individualsSelectionCount,
                                             Mutate *mutateMethod, Crossover *crossoverMethod, quint32 cooperatorsCount);
+    void startSteadyStateEvolution(quint32 generationCount,
+                                   EntitySelection *eliteSelection,
+                                   quint32 eliteSelectionCount,
+                                   EntitySelection *individualsSelection,
+                                   quint32 individualsSelectionCount,
+                                   Mutate *mutateMethod, Crossover *crossoverMethod, quint32 cooperatorsCount);
     void setEntitySelector(EntitySelection *eliteSelection, quint32 eliteSelectionCount, EntitySelection * individualsSelection, quint32 individualsSelectionCount);
     void setMutationMethod(Mutate * mutateMethod, quint32 mutationProbability);
     void setCrossoverMethod(Crossover * crossoverMethod);
+    void setRandomGenerator(const RandomGenerator &randomGenerator);
+    void setMigration(const QVector<Population *> &islandPopulations, quint32 island, quint32 migrationInterval, quint32 migrationSize, bool randomTopology);
+    inline quint32 getIsland() {return island;}
+    void setDiversityTarget(qreal diversityTarget);
 
     void replacePopulation();
     void replacePopulation(Population *population);
-    bool isElite(Genotype *genotype);
+    bool isElite(const BitString *genotypeData);
 
     StatisticEngine *getStatisticEngine();
     Population *getPopulation();
 
     vector<EntitySelection *> getEntitySelectors();
+    EntitySelection *getEntitySelector(const QString &name);
+    void setTournamentSize(quint32 tournamentSize);
     vector<Mutate *> getMutationMethods();
+    Mutate *getMutationMethod(const QString &name);
     vector<Crossover *> getCrossoverMethods();
+    Crossover *getCrossoverMethod(const QString &name);
 
     static QMutex * critMutex;
 
 protected:
+    void addCrossoverMethod(Crossover *crossoverMethod);
+    void addMutationMethod(Mutate *mutateMethod);
+
     quint32 generationCount;
     StatisticEngine statsEngine;
 
@@ -56,14 +81,20 @@ private:
     void selectIndividuals();
     void crossover();
     void mutate();
-
-    void waitOtherThread(QMutex *access, QSemaphore *semaphore);
+    void replaceGeneration();
+    void selectParents();
+    void replaceWorst(const BitString *genotypeData, qreal fitness);
+    void migrate(quint32 generation, quint32 generationCount);
+    void adaptRates();
 
     Population *population;
     qreal crossoverProbability;
     qreal mutationProbability;
     qreal mutationPerBitProbability;
-    static int state;
+    // Rates given to the engine, adapted to the diversity when there is a target
+    qreal baseCrossoverProbability;
+    qreal baseMutationPerBitProbability;
+    qreal diversityTarget;
 
     EntitySelection *eliteSelection;
     quint32 eliteSelectionCount;
@@ -73,14 +104,29 @@ private:
 
     Crossover *crossoverMethod;
 
+    // Stream drawn from by the thread running the evolution
+    RandomGenerator randomGenerator;
 
 
     vector<EntitySelection *> entitySelectionMethodList;
+    TournamentSelection *tournamentSelection;
     vector<Mutate *> mutateMethodList;
     vector<Crossover *> crossoverMethodList;
 
-    vector<PopEntity *> selectedEntitiesCopy;
-    vector<PopEntity *> evolvingEntitiesCopy;
+    // Populations of the same role of all the islands, this one included
+    QVector<Population *> islandPopulations;
+    quint32 island;
+    quint32 migrationInterval;
+    quint32 migrationSize;
+    bool randomTopology;
+    Elitism migrantSelection;
+    QVector<quint32> migrantPositions;
+
+    // Positions of the elites in the current generation
+    QVector<quint32> elitePositions;
+    // Positions of the selected individuals, then their copies in the next generation
+    QVector<quint32> evolvingPositions;
+    QVector<BitString *> evolvingGenotypes;
 };
 
 #endif // EVOLUTIONENGINE_H
@@ -20,8 +20,9 @@ void PopulationLogger::saveLogs(){
 
         for (vector< vector<PopEntity *> >::size_type u = 0; u < generationsLogs.size(); u++) {
             for (vector<PopEntity *>::size_type v = 0; v < generationsLogs[u].size(); v++) {
-                QString gene = QBitArrayUtility::bitArray2String(generationsLogs[u][v]->getGenotype()->getDataCopy());
-                bool isElite = evolutionEngine->isElite(generationsLogs[u][v]->getGenotype());
+                QBitArray bits = generationsLogs[u][v]->getGenotype()->getData()->toQBitArray();
+                QString gene = QBitArrayUtility::bitArray2String(&bits);
+                bool isElite = evolutionEngine->isElite(generationsLogs[u][v]->getGenotype()->getData());
                 stream << gene << "," << generationsLogs[u][v]->getFitness() << "," << (isElite? "1" : "0") << endl;
             }
         }
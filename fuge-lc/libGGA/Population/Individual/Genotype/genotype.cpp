@@ -6,21 +6,19 @@ Genotype::~Genotype(){
 }
 
 Genotype::Genotype(quint32 length) : length(length),
-    data(new QBitArray(length, false))
+    data(new BitString(length, false))
 {
 
 }
 
-Genotype::Genotype(QBitArray *data)
+Genotype::Genotype(const BitString *data) : length(data->size()),
+    data(new BitString(*data))
 {
-
-    this->data = new QBitArray(*data);
-    length = this->data->size();
 }
 
-Genotype::Genotype(Genotype *genotype)
+Genotype::Genotype(Genotype *genotype) : length(genotype->getLength()),
+    data(new BitString(*genotype->getData()))
 {
-    Genotype(genotype->getData());
 }
 Genotype *Genotype::getCopy(){
     return new Genotype(data);
@@ -30,16 +28,16 @@ quint32 Genotype::getLength(){
     return length;
 }
 
-QBitArray* Genotype::getData(){
+BitString* Genotype::getData(){
     return data;
 }
 
-QBitArray* Genotype::getDataCopy(){
-    return new QBitArray(*data);
+BitString* Genotype::getDataCopy(){
+    return new BitString(*data);
 }
 
-void Genotype::setData(QBitArray *data){
+void Genotype::setData(BitString *data){
     if(this->data!=NULL)
-        delete data;
+        delete this->data;
     this->data = data;
 }
@@ -1,7 +1,7 @@
 #ifndef GENOTYPE_H
 #define GENOTYPE_H
 #include <Qt>
-#include <QBitArray>
+#include "bitstring.h"
 #include <QString>
 #include <QDebug>
 
@@ -12,19 +12,19 @@ class Genotype
 {
 public:
     Genotype(quint32 length);
-    Genotype(QBitArray *data);
+    Genotype(const BitString *data);
     Genotype(Genotype *genotype);
     ~Genotype();
 
     Genotype *getCopy();
 
     quint32 getLength();
-    QBitArray *getData();
-    QBitArray *getDataCopy();
-    void setData(QBitArray *data);
+    BitString *getData();
+    BitString *getDataCopy();
+    void setData(BitString *data);
 private:
     quint32 length;
-    QBitArray *data;
+    BitString *data;
 
 };
 
@@ -27,6 +27,12 @@ PopEntity::PopEntity(PopEntity *popEntity) :
 {
 }
 
+PopEntity::PopEntity(const BitString *data, qreal fitness) :
+             genotype(new Genotype(data)),
+             fitness(fitness)
+{
+}
+
 bool PopEntity::operator< (PopEntity *rEntity)
 {
         return getFitness() < rEntity->getFitness();
@@ -16,6 +16,7 @@ public:
     PopEntity(quint32 lenght);
     PopEntity(Genotype *genotype);
     PopEntity(PopEntity *popEntity);
+    PopEntity(const BitString *data, qreal fitness);
     virtual bool operator< (PopEntity *rEntity);
 
     void setFitness(qreal fitness){
@@ -28,7 +29,6 @@ public:
 
 protected:
     Genotype *genotype;
-    RandomGenerator *randomGenerator;
     qreal fitness;
 };
 
@@ -3,6 +3,8 @@ include(Individual/Individual.pri)
 INCLUDEPATH += $$PWD
 DEPENDPATH += $$PWD
 
-SOURCES += $$PWD/population.cpp
+SOURCES += $$PWD/population.cpp \
+    $$PWD/representativeset.cpp
 
-HEADERS += $$PWD/population.h
+HEADERS += $$PWD/population.h \
+    $$PWD/representativeset.h
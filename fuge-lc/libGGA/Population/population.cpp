@@ -1,109 +1,215 @@
 #include "population.h"
+
+// Size of a cache line, in words
+#define LINE_WORDS 8
+
 Population::~Population(){
-    for(int i = 0; i < entityList.size(); i++)
-        delete entityList.at(i);
-    entityList.clear();
+    qDeleteAll(rows[0]);
+    qDeleteAll(rows[1]);
 }
 
-Population::Population(QString name, quint32 size, quint32 individualsLength) : name(name)
+Population::Population(QString name, quint32 size, quint32 individualsLength) :
+    representativesEpoch(0), representativesClosed(false), migrantsEpoch(0), migrantsClosed(false), name(name), size(size), individualsLength(individualsLength)
 {
-    for(int i = 0; i < entityList.size(); i++)
-        delete entityList.at(i);
-    entityList.clear();
-    for(quint32 i = 0; i < size; i++)
-    {
-        entityList.push_back(new PopEntity(individualsLength));
-    }
+    allocate();
+    randomizePopulation();
+}
+
+/**
+  * Create an integer coded population, of genotypes of one gene per range.
+  */
+Population::Population(QString name, quint32 size, const QVector<quint32> &geneRanges) :
+    representativesEpoch(0), representativesClosed(false), migrantsEpoch(0), migrantsClosed(false), name(name), size(size), individualsLength(geneRanges.size() * BitString::GENE_BITS),
+    geneRanges(geneRanges)
+{
+    for(int i = 0; i < geneRanges.size(); i++)
+        Q_ASSERT(geneRanges.at(i) > 0 && geneRanges.at(i) <= (Q_UINT64_C(1) << BitString::GENE_BITS));
+    allocate();
     randomizePopulation();
 }
 
-Population::Population(Population *population, QString name)
+Population::Population(Population *population, QString name) :
+    representativesEpoch(0), representativesClosed(false), migrantsEpoch(0), migrantsClosed(false), size(population->getSize()), individualsLength(population->getIndividualsLength()),
+    geneRanges(population->getGeneRanges())
 {
-    for(int i = 0; i < entityList.size(); i++)
-        delete entityList.at(i);
-    entityList.clear();
-    for(quint32 i = 0; i < population->getSize(); i++)
+    allocate();
+    for(quint32 i = 0; i < size; i++)
     {
-        entityList.push_back(population->getEntityCopyFrom(i));
+        *genotypeAt(i) = *population->genotypeAt(i);
+        setFitnessAt(i, population->getFitnessAt(i));
     }
-    if(name.isEmpty())
-        this->name = population->getName();
+    this->name = name.isEmpty() ? population->getName() : name;
 }
 
-void Population::setRepresentativesCopy(vector<PopEntity *> representatives, int quantity){
-    int nbCooperator = quantity;
+/**
+  * Allocate the rows of both generations in one block.
+  */
+void Population::allocate()
+{
+    stride = BitString::wordCountOf(individualsLength);
+    arena.fill(0, 2 * size * stride + LINE_WORDS - 1);
 
-    QMutexLocker locker(&mutex);
-    for(int i = 0; i < this->representatives.size(); i++)
-        delete this->representatives[i];
-    this->representatives.clear();
+    quint64 *words = arena.data();
+    while (((quintptr) words) % (LINE_WORDS * sizeof(quint64)) != 0)
+        words++;
 
-    // Random Cooperator (Working but not needed cooperators are the best ones only)
-    //        if(nbCooperator > 1){
-    //            nbCooperator--;
-    //            int pos = RandomGenerator::getGeneratorInstance()->random(0,entityList.size()-1);
-    //            this->representatives.push_back(new PopEntity(entityList.at(pos)));
-    //        }
+    for(int generation = 0; generation < 2; generation++)
+    {
+        rows[generation].resize(size);
+        for(quint32 i = 0; i < size; i++)
+        {
+            rows[generation][i] = new BitString(words, individualsLength);
+            words += stride;
+        }
+        fitnesses[generation].fill(0.0, size);
+    }
+    current = 0;
+}
 
+/**
+  * Publish the individuals at the given positions as the representatives of
+  * the population. The previous set stays valid for the readers still using it.
+  */
+void Population::publishRepresentatives(const QVector<quint32> &positions, int quantity){
+    int nbCooperator = qMin(quantity, (int) positions.size());
 
-    vector<PopEntity *>::iterator it;
-    for(it=representatives.begin(); it!= representatives.begin()+nbCooperator; it++){
-        this->representatives.push_back(new PopEntity(*it));
+    // Only the publisher writes the epoch, the readers read it under the lock
+    const quint64 epoch = representativesEpoch + 1;
+    shared_ptr<RepresentativeSet> published = make_shared<RepresentativeSet>(epoch, nbCooperator);
+    for(int i = 0; i < nbCooperator; i++){
+        published->append(genotypeAt(positions.at(i)), getFitnessAt(positions.at(i)));
     }
 
-}
+    QMutexLocker locker(&representativesLock);
+    representativesEpoch = epoch;
+    representativesQueue[epoch % 2] = published;
+    representativesPublished.wakeAll();
+}
+
+/**
+  * Wait for the representatives of the given epoch and return them. A reader
+  * is never more than one epoch behind the publisher, which may run one
+  * generation ahead, so the two last sets are enough. Once the population is
+  * closed, the last published set is returned instead, an empty pointer if
+  * none has been published.
+  */
+shared_ptr<const RepresentativeSet> Population::waitRepresentatives(quint64 epoch){
+    QMutexLocker locker(&representativesLock);
+    while(!representativesClosed && representativesEpoch < epoch)
+        representativesPublished.wait(&representativesLock);
+
+    const shared_ptr<const RepresentativeSet> &queued = representativesQueue[epoch % 2];
+    if(queued && queued->getEpoch() == epoch)
+        return queued;
+    Q_ASSERT(representativesClosed);
+    return representativesQueue[representativesEpoch % 2];
+}
+
+/**
+  * Wait until the representatives of the given epoch have been published and
+  * return the last published set, which may be of a later epoch. Once the
+  * population is closed, the last published set is returned at once, an
+  * empty pointer if none has been published.
+  */
+shared_ptr<const RepresentativeSet> Population::waitLatestRepresentatives(quint64 epoch){
+    QMutexLocker locker(&representativesLock);
+    while(!representativesClosed && representativesEpoch < epoch)
+        representativesPublished.wait(&representativesLock);
+    return representativesQueue[representativesEpoch % 2];
+}
+
+/**
+  * Release the readers waiting for representatives which will never be
+  * published, when the evolution of the population stops.
+  */
+void Population::closeRepresentatives(){
+    QMutexLocker locker(&representativesLock);
+    representativesClosed = true;
+    representativesPublished.wakeAll();
+}
+
+/**
+  * Send copies of the individuals at the given positions to the population of
+  * the destination island, as the migrants of the given migration. They are
+  * kept until the destination takes them with waitMigrants().
+  */
+void Population::sendMigrants(const QVector<quint32> &positions, int quantity, quint64 migration, int destination){
+    int nbMigrants = qMin(quantity, (int) positions.size());
+
+    shared_ptr<RepresentativeSet> sent = make_shared<RepresentativeSet>(migration, nbMigrants);
+    for(int i = 0; i < nbMigrants; i++){
+        sent->append(genotypeAt(positions.at(i)), getFitnessAt(positions.at(i)));
+    }
 
-vector<PopEntity *> Population::getRepresentativesCopy(){
-    QMutexLocker locker(&mutex);
-    vector<PopEntity *> temp;
-    vector<PopEntity *>::iterator it;
-    for(it=representatives.begin(); it!=representatives.end(); it++)
-        temp.push_back(new PopEntity(*it));
-    return temp;
+    QMutexLocker locker(&migrantsLock);
+    migrantsEpoch = migration;
+    migrantsQueue[migration % 4] = sent;
+    migrantsDestinations[migration % 4] = destination;
+    migrantsSent.wakeAll();
+}
+
+/**
+  * Wait for the migrants this population has sent at the given migration and
+  * return them if they were sent to the given destination island, an empty
+  * pointer otherwise. A destination takes them at its next migration, and
+  * this population waits for the batch of that migration after sending the
+  * one after it, so it is at most three batches ahead of a destination and
+  * the four last batches are enough. Migrations are numbered from 1, so
+  * migration 0 returns an empty pointer. Once the population is closed, the
+  * migrations it has not reached return an empty pointer.
+  */
+shared_ptr<const RepresentativeSet> Population::waitMigrants(quint64 migration, int destination){
+    if(migration == 0)
+        return shared_ptr<const RepresentativeSet>();
+
+    QMutexLocker locker(&migrantsLock);
+    while(!migrantsClosed && migrantsEpoch < migration)
+        migrantsSent.wait(&migrantsLock);
+
+    const shared_ptr<const RepresentativeSet> &queued = migrantsQueue[migration % 4];
+    if(queued && queued->getEpoch() == migration && migrantsDestinations[migration % 4] == destination)
+        return queued;
+    return shared_ptr<const RepresentativeSet>();
+}
+
+/**
+  * Release the islands waiting for migrants which will never be sent, when
+  * the evolution of the population stops.
+  */
+void Population::closeMigrants(){
+    QMutexLocker locker(&migrantsLock);
+    migrantsClosed = true;
+    migrantsSent.wakeAll();
 }
 
 QString Population::getName(){
     return name;
 }
 
-void Population::replace(vector<PopEntity *> newPopulation)
-{
-    QMutexLocker locker(&mutex);
-    for(int i = 0; i < entityList.size(); i++)
-        delete entityList.at(i);
-    entityList.clear();
-
-    vector<PopEntity *>::iterator it;
-    for(it=newPopulation.begin(); it!=newPopulation.end(); it++)
-    {
-        entityList.push_back(*it);
-    }
-}
-
-void Population::replace(vector<PopEntity *> base, vector<PopEntity *> generatedPartPopulation)
+quint32 Population::getSize()
 {
-    replace(generatedPartPopulation);
-
-    vector<PopEntity *>::iterator it;
-    for(it=base.begin(); it!=base.end(); it++)
-    {
-        entityList.push_back(*it);
-    }
+    return size;
 }
 
-quint32 Population::getSize()
+quint32 Population::getIndividualsLength()
 {
-    return entityList.size();
+    return individualsLength;
 }
 
 void Population::randomizePopulation()
 {
-    QBitArray *data;
+    BitString *data;
     bool status = false;
     for(quint32 i = 0; i < getSize(); i++)
     {
-        entityList.at(i)->setFitness(0.f);
-        data = entityList.at(i)->getGenotype()->getData();
+        setFitnessAt(i, 0.f);
+        data = genotypeAt(i);
+        if(isIntegerCoded())
+        {
+            for(int j=0; j < geneRanges.size(); j++)
+                data->setGene(j, RandomGenerator::getGeneratorInstance()->random(0, geneRanges.at(j)-1));
+            continue;
+        }
         for(int j=0; j < data->size(); j++)
         {
             status = RandomGenerator::getGeneratorInstance()->random(0,1);
@@ -112,44 +218,35 @@ void Population::randomizePopulation()
     }
 }
 
-// Individual functions
-PopEntity *Population::getEntityCopyFrom(quint32 pos)
+/**
+  * Copy an individual of the current generation to a row of the next one,
+  * with its fitness.
+  */
+void Population::copyToOffspring(quint32 pos, quint32 offspringPos)
 {
-    return getEntityAt(pos)->getCopy();
+    *offspringAt(offspringPos) = *genotypeAt(pos);
+    fitnesses[1 - current][offspringPos] = fitnesses[current].at(pos);
 }
 
-PopEntity *Population::getEntityAt(quint32 pos)
+/**
+  * Make the next generation the current one.
+  */
+void Population::commitGeneration()
 {
-    return entityList.at(pos);
+    current = 1 - current;
 }
 
-vector<PopEntity *> Population::getSomeEntityCopy(EntitySelection *entitySelection, quint32 count)
-{
-    vector<PopEntity *>::iterator it;
-    vector<PopEntity *> temp;
-    vector<PopEntity *> selected = entitySelection->selectEntities(count, entityList);
-
-    for(it=selected.begin(); it!=selected.end(); it++){
-        temp.push_back(new PopEntity(*it));
-    }
-    return temp;
-}
-
-vector<PopEntity *> Population::getSomeEntity(EntitySelection *entitySelection, quint32 count)
+// Individual functions
+PopEntity *Population::getEntityCopyFrom(quint32 pos)
 {
-    return entitySelection->selectEntities(count, entityList);
+    return new PopEntity(genotypeAt(pos), getFitnessAt(pos));
 }
 
 vector<PopEntity *> Population::getAllEntitiesCopy()
 {
-    vector<PopEntity *>::iterator it;
     vector<PopEntity *> temp;
-    for(it=entityList.begin(); it!=entityList.end(); it++){
-        temp.push_back(new PopEntity(*it));
+    for(quint32 i = 0; i < size; i++){
+        temp.push_back(getEntityCopyFrom(i));
     }
     return temp;
 }
-vector<PopEntity *> Population::getAllEntities()
-{
-    return entityList;
-}
@@ -2,43 +2,106 @@
 #define POPULATION_H
 
 #include <vector>
-#include <QMutexLocker>
+#include <memory>
+#include <QVector>
 #include <QDebug>
+#include <QMutex>
+#include <QWaitCondition>
 
 #include "popentity.h"
-#include "entityselection.h"
+#include "bitstring.h"
+#include "representativeset.h"
 #include "randomgenerator.h"
 
 using namespace std;
+
+/**
+ * The genotypes of a population are stored in one block of words, one row of
+ * a fixed number of words per individual, with the fitnesses in an array
+ * beside them. The block holds two generations : the current one, which is
+ * evaluated and selected from, and the next one, written by the reproduction.
+ * commitGeneration() swaps them, so that a generation needs no allocation.
+ *
+ * An integer coded population holds the range of each gene of its genotypes
+ * (see BitString::gene()), a gene taking the values from 0 to its range - 1.
+ *
+ * The representatives are published to the other population as an immutable
+ * RepresentativeSet, numbered by epoch. The two last sets are kept under a
+ * lock, so that the other population waits for the set of a given
+ * generation and then shares it without copying (see waitRepresentatives())
+ * while this one already breeds the next one, or takes the last one
+ * published (see waitLatestRepresentatives()).
+ *
+ * The migrants sent to the populations of the same role on other islands
+ * are kept in the same way, by migration number with their destination, so
+ * that each destination takes the batches of a given migration (see
+ * waitMigrants()) while this population already sends the next ones.
+ */
 class Population
 {
 public:
     Population(QString name, quint32 size, quint32 individualsLength);
+    Population(QString name, quint32 size, const QVector<quint32> &geneRanges);
     Population(Population *population, QString name = QString());
     ~Population();
 
     quint32 getSize();
-    void replace(vector<PopEntity *> newPopulation);
-    void replace(vector<PopEntity *> base, vector<PopEntity *> generatedPartPopulation);
+    quint32 getIndividualsLength();
+    inline bool isIntegerCoded() {return !geneRanges.isEmpty();}
+    inline const QVector<quint32> &getGeneRanges() {return geneRanges;}
     void randomizePopulation();
 
-    void setRepresentativesCopy(vector<PopEntity *> representatives, int quantity);
-    vector<PopEntity *> getRepresentativesCopy();
+    void publishRepresentatives(const QVector<quint32> &positions, int quantity);
+    shared_ptr<const RepresentativeSet> waitRepresentatives(quint64 epoch);
+    shared_ptr<const RepresentativeSet> waitLatestRepresentatives(quint64 epoch);
+    void closeRepresentatives();
+    void sendMigrants(const QVector<quint32> &positions, int quantity, quint64 migration, int destination);
+    shared_ptr<const RepresentativeSet> waitMigrants(quint64 migration, int destination);
+    void closeMigrants();
     QString getName();
 
-    PopEntity *getEntityCopyFrom(quint32 pos);
-    PopEntity *getEntityAt(quint32 pos);
+    inline BitString *genotypeAt(quint32 pos) {return rows[current].at(pos);}
+    inline qreal getFitnessAt(quint32 pos) {return fitnesses[current].at(pos);}
+    inline void setFitnessAt(quint32 pos, qreal fitness) {fitnesses[current][pos] = fitness;}
+    inline const QVector<qreal> &getFitnesses() {return fitnesses[current];}
+
+    inline BitString *offspringAt(quint32 pos) {return rows[1 - current].at(pos);}
+    void copyToOffspring(quint32 pos, quint32 offspringPos);
+    void commitGeneration();
 
-    vector<PopEntity *> getSomeEntityCopy(EntitySelection *entitySelection, quint32 count);
-    vector<PopEntity *> getSomeEntity(EntitySelection *entitySelection, quint32 count);
+    PopEntity *getEntityCopyFrom(quint32 pos);
     vector<PopEntity *> getAllEntitiesCopy();
-    vector<PopEntity *> getAllEntities();
 private:
-    vector<PopEntity *> representatives;
-    vector<PopEntity *> entityList;
-    QMutex mutex;
+    void allocate();
+
+    quint64 representativesEpoch;
+    // Sets of the two last epochs, by epoch % 2, guarded by representativesLock
+    shared_ptr<const RepresentativeSet> representativesQueue[2];
+    bool representativesClosed;
+    QMutex representativesLock;
+    QWaitCondition representativesPublished;
+    // Migrants of the four last migrations and their destinations, by migration % 4,
+    // guarded by migrantsLock
+    quint64 migrantsEpoch;
+    shared_ptr<const RepresentativeSet> migrantsQueue[4];
+    int migrantsDestinations[4];
+    bool migrantsClosed;
+    QMutex migrantsLock;
+    QWaitCondition migrantsSent;
     QString name;
 
+    quint32 size;
+    quint32 individualsLength;
+    // Empty for a population of bit strings
+    QVector<quint32> geneRanges;
+    // Words of a row
+    int stride;
+    // Both generations, the first row is aligned on a cache line
+    QVector<quint64> arena;
+    QVector<BitString *> rows[2];
+    QVector<qreal> fitnesses[2];
+    // Generation (0 or 1) which is the current one
+    int current;
 };
 
 #endif // POPULATION_H
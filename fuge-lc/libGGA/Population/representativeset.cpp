@@ -0,0 +1,16 @@
+#include "representativeset.h"
+
+RepresentativeSet::RepresentativeSet(quint64 epoch, int capacity) : epoch(epoch)
+{
+    genotypes.reserve(capacity);
+    fitnesses.reserve(capacity);
+}
+
+/**
+  * Add a copy of a genotype, before the set is published.
+  */
+void RepresentativeSet::append(const BitString *genotype, qreal fitness)
+{
+    genotypes.append(*genotype);
+    fitnesses.append(fitness);
+}
@@ -0,0 +1,58 @@
+/**
+ * @file representativeset.h
+ * @author ReDS (Reconfigurable and embedded digital systems) <www.reds.ch>
+ * @author HEIG-VD (Haute école d'ingénierie et de gestion) <www.heig-vd.ch>
+ * @date 10.2026
+ * @section LICENSE
+ *
+ * This application is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * @class RepresentativeSet
+ * @brief The representatives of a population published to the other one
+ *
+ * A RepresentativeSet is filled once by the population which publishes it,
+ * then only read, through a shared pointer to a const set. The readers
+ * keep the set alive as long as they use it, so a new set can be published
+ * at any time without waiting for them and without copying the genotypes.
+ * The epoch numbers the sets published by a population.
+ */
+
+#ifndef REPRESENTATIVESET_H
+#define REPRESENTATIVESET_H
+
+#include <QtGlobal>
+#include <QVector>
+
+#include "bitstring.h"
+
+class RepresentativeSet
+{
+public:
+    RepresentativeSet(quint64 epoch, int capacity);
+
+    void append(const BitString *genotype, qreal fitness);
+
+    inline quint64 getEpoch() const {return epoch;}
+    inline int getSize() const {return genotypes.size();}
+    inline const BitString *genotypeAt(int pos) const {return &genotypes.at(pos);}
+    inline qreal getFitnessAt(int pos) const {return fitnesses.at(pos);}
+
+private:
+    quint64 epoch;
+    QVector<BitString> genotypes;
+    QVector<qreal> fitnesses;
+};
+
+#endif // REPRESENTATIVESET_H
@@ -1,5 +1,84 @@
 #include "allpairpossibility.h"
 
-AllPairPossibility::AllPairPossibility(QList<Individual> *individualList) : PopulationDiversity(individualList)
+#include <QtAlgorithms>
+
+AllPairPossibility::AllPairPossibility(quint32 sampleCount) : PopulationDiversity(), sampleCount(sampleCount)
+{
+}
+
+QString AllPairPossibility::getName()
+{
+    return "AllPairPossibility";
+}
+
+/**
+  * Set the stream the sampled pairs are drawn from.
+  */
+void AllPairPossibility::setRandomGenerator(const RandomGenerator &randomGenerator)
+{
+    this->randomGenerator = randomGenerator;
+}
+
+quint32 AllPairPossibility::distance(const BitString *first, const BitString *second)
 {
+    const quint64 *firstWords = first->words();
+    const quint64 *secondWords = second->words();
+    quint32 count = 0;
+    for(int w = 0; w < first->wordCount(); w++)
+        count += qPopulationCount(firstWords[w] ^ secondWords[w]);
+    return count;
+}
+
+/**
+  * Number of genes which differ between two integer coded genotypes of
+  * geneCount genes.
+  */
+quint32 AllPairPossibility::geneDistance(const BitString *first, const BitString *second, int geneCount)
+{
+    quint32 count = 0;
+    for(int i = 0; i < geneCount; i++)
+        count += (first->gene(i) != second->gene(i));
+    return count;
+}
+
+/**
+  * Distance between two genotypes of the population, in genes for an
+  * integer coded population, in bits otherwise.
+  */
+quint32 AllPairPossibility::pairDistance(Population *population, quint32 first, quint32 second)
+{
+    if(population->isIntegerCoded())
+        return geneDistance(population->genotypeAt(first), population->genotypeAt(second), population->getGeneRanges().size());
+    return distance(population->genotypeAt(first), population->genotypeAt(second));
+}
+
+qreal AllPairPossibility::measure(Population *population)
+{
+    const quint32 size = population->getSize();
+    // The genes of an integer coded genotype are compared as a whole
+    const int length = population->isIntegerCoded() ? population->getGeneRanges().size() : population->getIndividualsLength();
+    if(size < 2 || length == 0)
+        return 0.0;
+
+    quint64 total = 0;
+    quint64 pairs = (quint64) size * (size - 1) / 2;
+    if(pairs <= sampleCount)
+    {
+        for(quint32 i = 0; i < size; i++)
+            for(quint32 j = i + 1; j < size; j++)
+                total += pairDistance(population, i, j);
+    }
+    else
+    {
+        for(quint32 k = 0; k < sampleCount; k++)
+        {
+            const quint32 i = randomGenerator.random(0, size - 1);
+            quint32 j = randomGenerator.random(0, size - 2);
+            if(j >= i)
+                j++;
+            total += pairDistance(population, i, j);
+        }
+        pairs = sampleCount;
+    }
+    return (qreal) total / ((qreal) pairs * length);
 }
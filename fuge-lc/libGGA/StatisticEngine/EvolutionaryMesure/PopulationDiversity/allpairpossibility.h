@@ -2,11 +2,36 @@
 #define ALLPAIRPOSSIBILITY_H
 
 #include "populationdiversity.h"
+#include "randomgenerator.h"
 
+/**
+ * Mean Hamming distance between two genotypes of the population, divided by
+ * their length : about 0.5 for a random population. The distance of a pair
+ * is the population count of the exclusive or of their words. The genotypes
+ * of an integer coded population are compared by gene instead, the distance
+ * being the number of different genes divided by the number of genes : about
+ * 1 - 1 / range for random genes of the same range. All the pairs
+ * are measured when there are at most sampleCount of them, sampleCount
+ * random pairs otherwise. The pairs are drawn from a stream of their own,
+ * given by setRandomGenerator(), so that measuring does not change the
+ * evolution.
+ */
 class AllPairPossibility : public PopulationDiversity
 {
 public:
-    AllPairPossibility(QList<Individual> *individualList);
+    AllPairPossibility(quint32 sampleCount = 1024);
+
+    qreal measure(Population *population);
+    QString getName();
+    void setRandomGenerator(const RandomGenerator &randomGenerator);
+
+private:
+    quint32 distance(const BitString *first, const BitString *second);
+    quint32 geneDistance(const BitString *first, const BitString *second, int geneCount);
+    quint32 pairDistance(Population *population, quint32 first, quint32 second);
+
+    quint32 sampleCount;
+    RandomGenerator randomGenerator;
 };
 
 #endif // ALLPAIRPOSSIBILITY_H
@@ -1,5 +1,59 @@
 #include "entropic.h"
 
-Entropic::Entropic(QList<Individual> *individualList) : PopulationDiversity(individualList)
+#include <cmath>
+
+Entropic::Entropic() : PopulationDiversity()
+{
+}
+
+QString Entropic::getName()
+{
+    return "Entropic";
+}
+
+qreal Entropic::measure(Population *population)
 {
+    const quint32 size = population->getSize();
+    const int length = population->getIndividualsLength();
+    if(size < 2 || length == 0)
+        return 0.0;
+
+    if(entropies.size() != (int) size + 1){
+        entropies.resize(size + 1);
+        for(quint32 n = 0; n <= size; n++){
+            const qreal p = (qreal) n / size;
+            entropies[n] = (n == 0 || n == size) ? 0.0 : -(p * log2(p) + (1.0 - p) * log2(1.0 - p));
+        }
+    }
+    int nbPlanes = 1;
+    while((Q_UINT64_C(1) << nbPlanes) <= size)
+        nbPlanes++;
+    planes.resize(nbPlanes);
+
+    qreal entropy = 0.0;
+    const int nbWords = BitString::wordCountOf(length);
+    for(int w = 0; w < nbWords; w++)
+    {
+        planes.fill(0);
+        for(quint32 i = 0; i < size; i++)
+        {
+            quint64 carry = population->genotypeAt(i)->words()[w];
+            for(int p = 0; carry != 0; p++)
+            {
+                const quint64 next = planes.at(p) & carry;
+                planes[p] ^= carry;
+                carry = next;
+            }
+        }
+
+        const int bits = qMin(64, length - 64 * w);
+        for(int b = 0; b < bits; b++)
+        {
+            quint32 count = 0;
+            for(int p = 0; p < nbPlanes; p++)
+                count |= (quint32) ((planes.at(p) >> b) & 1) << p;
+            entropy += entropies.at(count);
+        }
+    }
+    return entropy / length;
 }
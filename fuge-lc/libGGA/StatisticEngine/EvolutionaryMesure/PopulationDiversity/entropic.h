@@ -1,12 +1,32 @@
 #ifndef ENTROPIC_H
 #define ENTROPIC_H
 
+#include <QVector>
+
 #include "populationdiversity.h"
 
+/**
+ * Mean entropy of the bits of the genotypes : 1 when each bit is set in
+ * half of the population, 0 when each bit has the same value everywhere.
+ *
+ * The ones of each bit are counted for 64 bits at once, by adding the words
+ * of the genotypes into counters stored as bit planes (a carry-save adder),
+ * so that a generation costs about two word operations per word of the
+ * population.
+ */
 class Entropic : public PopulationDiversity
 {
 public:
-    Entropic(QList<Individual> *individualList);
+    Entropic();
+
+    qreal measure(Population *population);
+    QString getName();
+
+private:
+    // Bit planes of the counters of a word, least significant plane first
+    QVector<quint64> planes;
+    // Entropy of a bit set in n individuals, by n
+    QVector<qreal> entropies;
 };
 
 #endif // ENTROPIC_H
@@ -1,5 +1,5 @@
 #include "populationdiversity.h"
 
-PopulationDiversity::PopulationDiversity(QList<Individual> *individualList) : EvolutionaryMesure(individualList)
+PopulationDiversity::PopulationDiversity() : EvolutionaryMesure()
 {
 }
@@ -3,10 +3,14 @@
 
 #include "evolutionarymesure.h"
 
+/**
+ * A diversity of the genotypes of a population, from 0 when all the
+ * genotypes are equal to 1 at most.
+ */
 class PopulationDiversity : public EvolutionaryMesure
 {
 public:
-    PopulationDiversity(QList<Individual> *individualList);
+    PopulationDiversity();
 };
 
 #endif // POPULATIONDIVERSITY_H
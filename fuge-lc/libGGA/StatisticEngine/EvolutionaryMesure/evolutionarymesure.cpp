@@ -1,5 +1,9 @@
-    #include "evolutionarymesure.h"
+#include "evolutionarymesure.h"
 
-EvolutionaryMesure::EvolutionaryMesure(QList<Individual> *individualList) : individualList(individualList)
+EvolutionaryMesure::EvolutionaryMesure()
+{
+}
+
+EvolutionaryMesure::~EvolutionaryMesure()
 {
 }
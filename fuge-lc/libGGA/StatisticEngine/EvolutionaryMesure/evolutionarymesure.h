@@ -1,19 +1,22 @@
 #ifndef EVOLUTIONARYMESURE_H
 #define EVOLUTIONARYMESURE_H
 
-#include <QList>
+#include <QString>
 
-#include "individual.h"
+#include "population.h"
 
+/**
+ * A measure of the current generation of a population, computed straight
+ * from the rows of its genotypes.
+ */
 class EvolutionaryMesure
 {
 public:
-    EvolutionaryMesure(QList<Individual> *individualList);
+    EvolutionaryMesure();
+    virtual ~EvolutionaryMesure();
 
-protected:
-    QList<Individual> *individualList;
-
-private:
+    virtual qreal measure(Population *population) = 0;
+    virtual QString getName() = 0;
 };
 
 #endif // EVOLUTIONARYMESURE_H
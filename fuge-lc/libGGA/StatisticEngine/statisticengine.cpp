@@ -1,6 +1,6 @@
 #include "statisticengine.h"
 
-StatisticEngine::StatisticEngine() : minfitness(0.0), maxfitness(0.0), meanfitness(0.0), standardDeviation(0.0)
+StatisticEngine::StatisticEngine() : minfitness(0.0), maxfitness(0.0), meanfitness(0.0), standardDeviation(0.0), bitEntropy(0.0), pairDistance(0.0)
 {
 }
 void StatisticEngine::addFitness(qreal fitness){
@@ -33,6 +33,21 @@ void StatisticEngine::reset(){
     fitnesslist.clear();
 }
 
+/**
+  * Measure the diversity of the genotypes of the current generation.
+  */
+void StatisticEngine::buildDiversity(Population *population){
+    bitEntropy = entropic.measure(population);
+    pairDistance = allPairPossibility.measure(population);
+}
+
+/**
+  * Set the stream the diversity measures draw their samples from.
+  */
+void StatisticEngine::setRandomGenerator(const RandomGenerator &randomGenerator){
+    allPairPossibility.setRandomGenerator(randomGenerator);
+}
+
 qreal StatisticEngine::getMinFitness(){
     return minfitness;
 }
@@ -48,3 +63,11 @@ qreal StatisticEngine::getMeanFitness(){
 qreal StatisticEngine::getStandardDeviation(){
     return standardDeviation;
 }
+
+qreal StatisticEngine::getBitEntropy(){
+    return bitEntropy;
+}
+
+qreal StatisticEngine::getPairDistance(){
+    return pairDistance;
+}
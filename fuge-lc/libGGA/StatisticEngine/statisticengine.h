@@ -4,6 +4,8 @@
 #include <QList>
 #include <vector>
 #include "evolutionarymesure.h"
+#include "entropic.h"
+#include "allpairpossibility.h"
 #include "math.h"
 class StatisticEngine
 {
@@ -12,11 +14,15 @@ public:
     void addFitness(qreal fitness);
     void buildStats();
     void reset();
+    void buildDiversity(Population *population);
+    void setRandomGenerator(const RandomGenerator &randomGenerator);
 
     qreal getMinFitness();
     qreal getMaxFitness();
     qreal getMeanFitness();
     qreal getStandardDeviation();
+    qreal getBitEntropy();
+    qreal getPairDistance();
 
 private:
     QList<qreal> fitnesslist;
@@ -25,7 +31,11 @@ private:
     qreal meanfitness;
     qreal standardDeviation;
 
-    QList<EvolutionaryMesure> evolutionaryMesures;
+    // Diversity of the last population measured, kept by reset()
+    Entropic entropic;
+    AllPairPossibility allPairPossibility;
+    qreal bitEntropy;
+    qreal pairDistance;
 };
 
 #endif // STATISTICENGINE_H
@@ -1,9 +1,11 @@
 INCLUDEPATH += $$PWD
 DEPENDPATH += $$PWD
 
-SOURCES += $$PWD/qbitarrayutility.cpp \
+SOURCES += $$PWD/bitstring.cpp \
+    $$PWD/qbitarrayutility.cpp \
     $$PWD/randomgenerator.cpp
     
-HEADERS += $$PWD/qbitarrayutility.h \
+HEADERS += $$PWD/bitstring.h \
+    $$PWD/qbitarrayutility.h \
     $$PWD/randomgenerator.h
     
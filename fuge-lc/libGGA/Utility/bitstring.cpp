@@ -0,0 +1,96 @@
+#include "bitstring.h"
+
+BitString::BitString() : length(0), nbWords(0), view(false), bits(NULL)
+{
+}
+
+BitString::BitString(int size, bool value) : length(size),
+    nbWords(wordCountOf(size)), view(false), storage(wordCountOf(size), 0)
+{
+    bits = storage.data();
+    if (value)
+        fill(true);
+}
+
+/**
+  * Build a view on words owned by the caller, which must outlive the view.
+  *
+  * @param words First word of the string.
+  * @param size Number of bits of the string.
+  */
+BitString::BitString(quint64 *words, int size) : length(size),
+    nbWords(wordCountOf(size)), view(true), bits(words)
+{
+}
+
+BitString::BitString(const BitString &other) : length(other.length),
+    nbWords(other.nbWords), view(false), storage(other.nbWords)
+{
+    bits = storage.data();
+    memcpy(bits, other.bits, nbWords * sizeof(quint64));
+}
+
+/**
+  * Copy the bits of another string. The words are copied in place when both
+  * strings have the same size, a view can only be assigned a string of its size.
+  */
+BitString &BitString::operator=(const BitString &other)
+{
+    if (this == &other)
+        return *this;
+    if (length != other.length) {
+        Q_ASSERT(!view);
+        length = other.length;
+        nbWords = other.nbWords;
+        storage.resize(nbWords);
+        bits = storage.data();
+    }
+    memcpy(bits, other.bits, nbWords * sizeof(quint64));
+    return *this;
+}
+
+/**
+  * Set all the bits to the given value.
+  */
+void BitString::fill(bool value)
+{
+    const quint64 word = value ? ~Q_UINT64_C(0) : 0;
+    for (int i = 0; i < nbWords; i++) {
+        bits[i] = word;
+    }
+    clearPadding();
+}
+
+/**
+  * Clear the unused bits of the last word, after whole words have been written.
+  */
+void BitString::clearPadding()
+{
+    if (length % 64 != 0)
+        bits[nbWords - 1] &= (Q_UINT64_C(1) << (length % 64)) - 1;
+}
+
+/**
+  * Return the bits as a string of '0' and '1', first bit first.
+  */
+QString BitString::toString() const
+{
+    QString str(length, QChar('0'));
+    for (int i = 0; i < length; i++) {
+        if (at(i))
+            str[i] = QChar('1');
+    }
+    return str;
+}
+
+/**
+  * Return a copy of the bits as a QBitArray.
+  */
+QBitArray BitString::toQBitArray() const
+{
+    QBitArray array(length);
+    for (int i = 0; i < length; i++) {
+        array.setBit(i, at(i));
+    }
+    return array;
+}
@@ -0,0 +1,134 @@
+/**
+ * @file bitstring.h
+ * @author ReDS (Reconfigurable and embedded digital systems) <www.reds.ch>
+ * @author HEIG-VD (Haute école d'ingénierie et de gestion) <www.heig-vd.ch>
+ * @date 10.2026
+ * @section LICENSE
+ *
+ * This application is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * @class BitString
+ * @brief A string of bits stored in 64 bits words
+ *
+ * BitString holds the genotypes. The bit i is the bit i%64 of the word
+ * i/64, and the unused bits of the last word are always 0, so that whole
+ * words can be compared and copied. A field of consecutive bits is read
+ * at once with shifts and masks (see field()), the first bit of the field
+ * being its least significant bit, as the genomes are decoded.
+ *
+ * An integer coded genotype is a string of genes of GENE_BITS bits, each
+ * gene lying in a single word (see gene()).
+ *
+ * A BitString either owns its words or is a view on words owned by
+ * somebody else (the rows of a Population). A copy always owns its words,
+ * and an assignment between strings of the same size copies the words in
+ * place, so that a view can be written without any allocation.
+ */
+
+#ifndef BITSTRING_H
+#define BITSTRING_H
+#include <cstring>
+#include <QtGlobal>
+#include <QVector>
+#include <QString>
+#include <QBitArray>
+
+class BitString
+{
+public:
+    BitString();
+    BitString(int size, bool value = false);
+    BitString(quint64 *words, int size);
+    BitString(const BitString &other);
+    BitString &operator=(const BitString &other);
+
+    static inline int wordCountOf(int size) {return (size + 63) / 64;}
+
+    inline int size() const {return length;}
+    inline int wordCount() const {return nbWords;}
+    inline bool isView() const {return view;}
+    inline const quint64 *words() const {return bits;}
+    inline quint64 *words() {return bits;}
+
+    inline bool at(int i) const
+    {
+        return (bits[i >> 6] >> (i & 63)) & 1;
+    }
+    inline bool testBit(int i) const {return at(i);}
+    inline void setBit(int i, bool value)
+    {
+        const quint64 mask = Q_UINT64_C(1) << (i & 63);
+        if (value)
+            bits[i >> 6] |= mask;
+        else
+            bits[i >> 6] &= ~mask;
+    }
+    inline void toggleBit(int i)
+    {
+        bits[i >> 6] ^= Q_UINT64_C(1) << (i & 63);
+    }
+
+    /**
+      * Read a field of consecutive bits.
+      *
+      * @param position Index of the first bit of the field, its least significant bit.
+      * @param width Number of bits of the field, at most 32.
+      * @return the value of the field.
+      */
+    inline quint32 field(int position, int width) const
+    {
+        const int word = position >> 6;
+        const int shift = position & 63;
+        quint64 value = bits[word] >> shift;
+        if (shift + width > 64)
+            value |= bits[word + 1] << (64 - shift);
+        return (quint32) (value & ((Q_UINT64_C(1) << width) - 1));
+    }
+
+    /**
+      * Number of bits of a gene of an integer coded genotype, dividing 64.
+      */
+    static const int GENE_BITS = 16;
+
+    inline quint32 gene(int index) const {return field(index * GENE_BITS, GENE_BITS);}
+    inline void setGene(int index, quint32 value)
+    {
+        const int shift = (index * GENE_BITS) & 63;
+        const quint64 mask = ((Q_UINT64_C(1) << GENE_BITS) - 1) << shift;
+        quint64 &word = bits[(index * GENE_BITS) >> 6];
+        word = (word & ~mask) | (((quint64) value << shift) & mask);
+    }
+
+    void fill(bool value);
+    void clearPadding();
+    QString toString() const;
+    QBitArray toQBitArray() const;
+
+    inline bool operator==(const BitString &other) const
+    {
+        return length == other.length &&
+               memcmp(bits, other.bits, nbWords * sizeof(quint64)) == 0;
+    }
+    inline bool operator!=(const BitString &other) const {return !(*this == other);}
+
+private:
+    int length;
+    int nbWords;
+    bool view;
+    quint64 *bits;
+    QVector<quint64> storage;
+};
+
+#endif // BITSTRING_H
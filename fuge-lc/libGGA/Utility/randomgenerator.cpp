@@ -23,40 +23,95 @@
  * @class RandomGenerator
  * @brief A random generator
  *
- * RandomGenerator is a random generator, thread safe.
- * It uses the Qt function qsrand and qrand to be multi-platform
- * compatible.
- * RangomGenerator works as a singleton and by so
- * no pointer of it should be kept on the user code.
+ * xoshiro256** by David Blackman and Sebastiano Vigna, seeded with splitmix64.
  */
 
 #include "randomgenerator.h"
-#include <cstdlib>
 
-RandomGenerator* RandomGenerator::randomGenerator = NULL;
+// Generator of the calling thread
+static thread_local RandomGenerator *threadGenerator = NULL;
 
-RandomGenerator::RandomGenerator() :
-    QThread()
-{}
+// Jump of 2^128 draws, separating the streams of a run
+static const quint64 JUMP[] = {Q_UINT64_C(0x180ec6d33cfd0aba), Q_UINT64_C(0xd5a61266f0c9392c),
+                               Q_UINT64_C(0xa9582618e03fc9aa), Q_UINT64_C(0x39abdc4529b1661c)};
+// Jump of 2^192 draws, separating the runs
+static const quint64 LONG_JUMP[] = {Q_UINT64_C(0x76e15d3efefdcbbf), Q_UINT64_C(0xc5004e441c522fb3),
+                                    Q_UINT64_C(0x77710069854ee241), Q_UINT64_C(0x39109bb02acbe635)};
+
+/**
+  * Shared generator, for the threads without their own one.
+  */
+static RandomGenerator &sharedGenerator()
+{
+    static RandomGenerator generator;
+    return generator;
+}
+
+/**
+  * Build the generator of a stream of a run.
+  *
+  * @param seed Seed of all the runs.
+  * @param run Number of the run.
+  * @param stream Number of the stream in the run.
+  */
+RandomGenerator::RandomGenerator(quint64 seed, quint32 run, quint32 stream)
+{
+    quint64 x = seed;
+    for(int i = 0; i < 4; i++){
+        // splitmix64
+        quint64 z = (x += Q_UINT64_C(0x9e3779b97f4a7c15));
+        z = (z ^ (z >> 30)) * Q_UINT64_C(0xbf58476d1ce4e5b9);
+        z = (z ^ (z >> 27)) * Q_UINT64_C(0x94d049bb133111eb);
+        state[i] = z ^ (z >> 31);
+    }
+    for(quint32 i = 0; i < run; i++)
+        jump(LONG_JUMP);
+    for(quint32 i = 0; i < stream; i++)
+        jump(JUMP);
+}
 
 RandomGenerator *RandomGenerator::getGeneratorInstance(){
+    if(threadGenerator != NULL)
+        return threadGenerator;
+    return &sharedGenerator();
+}
 
-    if(randomGenerator == NULL)
-        randomGenerator = new RandomGenerator();
+void RandomGenerator::setThreadGenerator(RandomGenerator *generator){
+    threadGenerator = generator;
+}
 
-    return randomGenerator;
+/**
+  * Advance the generator by the number of draws given by a jump polynomial.
+  */
+void RandomGenerator::jump(const quint64 *polynomial){
+    quint64 jumped[4] = {0, 0, 0, 0};
+    for(int i = 0; i < 4; i++){
+        for(int b = 0; b < 64; b++){
+            if(polynomial[i] & (Q_UINT64_C(1) << b)){
+                for(int k = 0; k < 4; k++)
+                    jumped[k] ^= state[k];
+            }
+            randomWord();
+        }
+    }
+    for(int k = 0; k < 4; k++)
+        state[k] = jumped[k];
 }
 
 qint32 RandomGenerator::random(qint32 min, qint32 max){
     if (min > max){
         qSwap(min,max);
     }
-    return QRandomGenerator::global()->generate()%(max-min+1) + min;
+    // Multiply the 32 high bits by the size of the range, without a modulo
+    const quint64 range = (quint64) ((qint64) max - (qint64) min + 1);
+    return (qint32) ((qint64) min + (qint64) (((randomWord() >> 32) * range) >> 32));
 }
 
 qreal RandomGenerator::randomReal(qreal min, qreal max){
     if (min > max) {
         qSwap(min, max);
     }
-    return QRandomGenerator::global()->generateDouble()*(max-min) + min;
+    // 53 random bits in [0,1[
+    const qreal luck = (randomWord() >> 11) * (1.0 / 9007199254740992.0);
+    return luck*(max-min) + min;
 }
@@ -23,38 +23,43 @@
  * @class RandomGenerator
  * @brief A random generator
  *
- * RandomGenerator is a random generator, thread safe.
- * It uses the Qt function qsrand and qrand to be multi-platform
- * compatible.
- * RangomGenerator works as a singleton and by so
- * no pointer of it should be kept on the user code.
+ * RandomGenerator is a xoshiro256** generator. All the generators of a
+ * program come from a single seed : the stream of a generator is
+ * given by the number of the run and the number of the stream in the run,
+ * and the streams are made independent with the jump-ahead functions of the
+ * generator. A run is thus reproduced from its seed whatever the threads
+ * the streams are used by.
+ *
+ * Each thread draws from its own generator, installed with
+ * setThreadGenerator(), which getGeneratorInstance() returns. The threads
+ * without a generator share the stream 0 of the run 0 of the seed 0, they
+ * must not draw concurrently. No pointer of it should be kept on the user code.
  */
 
 #ifndef RANDOMGENERATOR_H
 #define RANDOMGENERATOR_H
-#include <QThread>
-#include <QMutexLocker>
-#include <QMutex>
-#include <QTime>
-#include <QList>
-#include <QThread>
-#include <memory>
-#include <QRandomGenerator>
+#include <QtGlobal>
 
-using namespace std;
-class RandomGenerator : public QThread
+class RandomGenerator
 {
-    Q_OBJECT
 public:
+    RandomGenerator(quint64 seed = 0, quint32 run = 0, quint32 stream = 0);
+
     /**
-      * Get a random generator instance.
-      *
-      * This function is thread safe.
+      * Get the random generator of the calling thread.
       *
-      * @return the RandomGenerator singleton.
+      * @return the generator installed for the thread, or the shared one.
       */
     static RandomGenerator *getGeneratorInstance();
 
+    /**
+      * Install the random generator of the calling thread.
+      *
+      * @param generator
+      *     the generator, NULL to use the shared one again.
+      */
+    static void setThreadGenerator(RandomGenerator *generator);
+
     /**
       * Get a random number.
       *
@@ -83,11 +88,30 @@ public:
       */
     qreal randomReal(qreal min, qreal max);
 
-protected:
-    RandomGenerator();
+    /**
+      * Get a random word.
+      *
+      * @return random
+      *     64 random bits.
+      */
+    inline quint64 randomWord()
+    {
+        const quint64 result = rotl(state[1] * 5, 7) * 9;
+        const quint64 t = state[1] << 17;
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = rotl(state[3], 45);
+        return result;
+    }
 
 private:
-    static RandomGenerator* randomGenerator;
+    static inline quint64 rotl(quint64 x, int k) {return (x << k) | (x >> (64 - k));}
+    void jump(const quint64 *polynomial);
+
+    quint64 state[4];
 };
 
 #endif // RANDOMGENERATOR_H
@@ -35,6 +35,7 @@
 QString datasetFile;
 QString scriptFile;
 QString fuzzyFile;
+QString outputFile;
 bool useGUI= true;
 bool dataLoaded = false;
 bool scriptLoaded = false;
@@ -53,12 +54,42 @@ void showHelp()
     std::cout << " --verbose : Verbose output" << std::endl << std::endl;
     std::cout << " --evaluate : Perform an evaluation of the given fuzzy system on the specified database" << std::endl << std::endl;
     std::cout << " --predict : Perform a prediction of the given fuzzy system on the specified database" << std::endl << std::endl;
+    std::cout << " --fixed-point : Evaluate the fuzzy systems with 16 bits fixed point inputs and degrees" << std::endl;
+    std::cout << "                 and report the fitness deviation against the floating point evaluation" << std::endl << std::endl;
+    std::cout << " --cache : Keep a binary image of the dataset next to it (<dataset>.fcache) and map it" << std::endl;
+    std::cout << "           instead of parsing the CSV file again while the dataset is unchanged" << std::endl << std::endl;
+    std::cout << " --collapse-duplicates : Evolve on the distinct samples of the dataset, each one weighted" << std::endl;
+    std::cout << "                         by its number of occurrences" << std::endl << std::endl;
+    std::cout << " --steady-state : Evolve the populations one child at a time, replacing the worst individual," << std::endl;
+    std::cout << "                  instead of breeding a whole generation at once" << std::endl << std::endl;
+    std::cout << " --steady-state-lockstep : Evolve the populations in steady state, each batch of children" << std::endl;
+    std::cout << "                           waiting for the representatives of the same batch of the other" << std::endl;
+    std::cout << "                           population, so that the run is reproduced by its seed" << std::endl << std::endl;
+    std::cout << " --seed : Seed of the random generators, to reproduce the runs (random by default)" << std::endl;
+    std::cout << "          Value : Unsigned 64 bits number, as printed by [Seed]" << std::endl << std::endl;
+    std::cout << " --time-budget : Stop the runs once the given time has elapsed since the start, the time" << std::endl;
+    std::cout << "                 left being shared between the runs left in the script" << std::endl;
+    std::cout << "                 Value : Number of seconds" << std::endl << std::endl;
+    std::cout << " --eval-budget : Stop the runs once the given number of fuzzy systems have been evaluated," << std::endl;
+    std::cout << "                 the evaluations left being shared between the runs left in the script" << std::endl;
+    std::cout << "                 Value : Number of evaluations" << std::endl << std::endl;
+    std::cout << " --save-interval : Save the best system so far of a run periodically" << std::endl;
+    std::cout << "                   (to <save path>temp/currentBest_<process id>.ffs)" << std::endl;
+    std::cout << "                   Value : Number of seconds between the saves" << std::endl << std::endl;
     std::cout << " -d  : Dataset  (required to run automatically from command line)" << std::endl;
     std::cout << "       Value : Path to the dataset" << std::endl << std::endl;
     std::cout << " -s  : Script   (required to run automatically from command line)" << std::endl;
     std::cout << "       Value : Path to the execution script" << std::endl << std::endl;;
     std::cout << " -f  : Fuzzy system   (required for evalation/prediction)" << std::endl;
     std::cout << "       Value : Path to the fuzzy system file" << std::endl << std::endl;;
+    std::cout << " -o  : Output   (optionnal, evaluation/prediction)" << std::endl;
+    std::cout << "       Value : Path to the CSV file receiving the output values and classes of each sample" << std::endl;
+    std::cout << "               (standard output by default for a prediction)" << std::endl << std::endl;
+    std::cout << " -r  : Run state   (optionnal, creation)" << std::endl;
+    std::cout << "       Value : Path to the file receiving the final populations and universes of the run." << std::endl;
+    std::cout << "               If it exists, the run resumes from it on the dataset with appended samples" << std::endl << std::endl;
+    std::cout << " -n  : Generations of a resumed run   (optionnal, creation)" << std::endl;
+    std::cout << "       Value : Number of generations (a quarter of the script generations by default)" << std::endl << std::endl;
     std::cout << " -g  : GUI  (optionnal)" << std::endl;
     std::cout << "       Value : yes (Show the GUI) " << std::endl;
     std::cout << "               no  (Do not show the GUI) " << std::endl << std::endl;
@@ -147,6 +178,26 @@ bool parseArguments(QStringList args)
                 return false;
             }
         }
+        // Output file parameter
+        else if (args.at(i).at(1) == QChar('o')) {
+            outputFile = args.at(i+1);
+        }
+        // Run state file parameter
+        else if (args.at(i).at(1) == QChar('r')) {
+            SystemParameters& sysParams = SystemParameters::getInstance();
+            sysParams.setRunStateFile(args.at(i+1));
+        }
+        // Generations of a resumed run parameter
+        else if (args.at(i).at(1) == QChar('n')) {
+            bool isOk = false;
+            const int generations = args.at(i+1).toInt(&isOk);
+            if (!isOk || generations <= 0) {
+                std::cout << std::endl << "Error : incorrect value \"" << args.at(i+1).toStdString() << "\" !" << std::endl << std::endl;
+                return false;
+            }
+            SystemParameters& sysParams = SystemParameters::getInstance();
+            sysParams.setResumeGenerations(generations);
+        }
         // Gui parameter
         else if (args.at(i).at(1) == QChar('g')) {
             if (args.at(i+1) == QString("yes")) {
@@ -170,6 +221,64 @@ bool parseArguments(QStringList args)
             else if (args.at(i) == "--predict") {
                 predict = true;
             }
+            else if (args.at(i) == "--fixed-point") {
+                SystemParameters& sysParams = SystemParameters::getInstance();
+                sysParams.setReducedPrecision(true);
+            }
+            else if (args.at(i) == "--cache") {
+                SystemParameters& sysParams = SystemParameters::getInstance();
+                sysParams.setDatasetCache(true);
+            }
+            else if (args.at(i) == "--collapse-duplicates") {
+                SystemParameters& sysParams = SystemParameters::getInstance();
+                sysParams.setCollapseDuplicates(true);
+            }
+            else if (args.at(i) == "--steady-state") {
+                SystemParameters& sysParams = SystemParameters::getInstance();
+                sysParams.setSteadyState(true);
+            }
+            else if (args.at(i) == "--steady-state-lockstep") {
+                SystemParameters& sysParams = SystemParameters::getInstance();
+                sysParams.setSteadyState(true);
+                sysParams.setSteadyStateLockstep(true);
+            }
+            else if (args.at(i) == "--seed" && i+1 < args.size()) {
+                bool isOk = false;
+                const quint64 seed = args.at(i+1).toULongLong(&isOk);
+                if (!isOk) {
+                    std::cout << std::endl << "Error : incorrect value \"" << args.at(i+1).toStdString() << "\" !" << std::endl << std::endl;
+                    return false;
+                }
+                SystemParameters& sysParams = SystemParameters::getInstance();
+                sysParams.setSeed(seed);
+                // The value is skipped with the option
+                continue;
+            }
+            else if ((args.at(i) == "--time-budget" || args.at(i) == "--save-interval") && i+1 < args.size()) {
+                bool isOk = false;
+                const double seconds = args.at(i+1).toDouble(&isOk);
+                if (!isOk || seconds <= 0.0) {
+                    std::cout << std::endl << "Error : incorrect value \"" << args.at(i+1).toStdString() << "\" !" << std::endl << std::endl;
+                    return false;
+                }
+                SystemParameters& sysParams = SystemParameters::getInstance();
+                if (args.at(i) == "--time-budget")
+                    sysParams.setTimeBudget(seconds * 1000.0);
+                else
+                    sysParams.setSaveInterval(seconds * 1000.0);
+                continue;
+            }
+            else if (args.at(i) == "--eval-budget" && i+1 < args.size()) {
+                bool isOk = false;
+                const quint64 evaluations = args.at(i+1).toULongLong(&isOk);
+                if (!isOk || evaluations == 0) {
+                    std::cout << std::endl << "Error : incorrect value \"" << args.at(i+1).toStdString() << "\" !" << std::endl << std::endl;
+                    return false;
+                }
+                SystemParameters& sysParams = SystemParameters::getInstance();
+                sysParams.setEvaluationBudget(evaluations);
+                continue;
+            }
             else {
                 invalidParam();
                 return false;
@@ -230,7 +339,7 @@ int main(int argc, char *argv[])
     if (parseArguments(a.arguments())) {
 
         FugeMain w;
-        w.runFromCmdLine(datasetFile, scriptFile, fuzzyFile, eval, predict, verbose);
+        w.runFromCmdLine(datasetFile, scriptFile, fuzzyFile, outputFile, eval, predict, verbose);
 
         if (!eval && !predict) {
             return a.exec();
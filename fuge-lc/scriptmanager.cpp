@@ -47,7 +47,10 @@ struct ScriptManager::Imp
     duk_context* engine;
     QString fileName;
     bool scriptReady;
-    Imp():engine(0),scriptReady(false){}
+    // Set while doRun() is executed only to count the runs of the script
+    bool countingRuns;
+    int countedRuns;
+    Imp():engine(0),scriptReady(false),countingRuns(false),countedRuns(0){}
 
     void doRun()
     {
@@ -59,6 +62,22 @@ struct ScriptManager::Imp
         duk_pop(engine);
     }
 
+    /**
+      * Execute doRun() without starting its runs, to count them, so that the
+      * budgets can be shared between them. The script must then not depend
+      * on the results of its runs to decide on the next ones.
+      */
+    void countRuns()
+    {
+        countingRuns = true;
+        countedRuns = 0;
+        doRun();
+        countingRuns = false;
+        SystemParameters& sysParams = SystemParameters::getInstance();
+        sysParams.setPlannedRuns(qMax(1, countedRuns));
+        sysParams.setStartedRuns(0);
+    }
+
     void doSetParams()
     {
         duk_get_global_string (engine , "doSetParams" );
@@ -121,6 +140,75 @@ static duk_ret_t _setParams(duk_context * ctx)
     return 0;
 }
 
+static duk_ret_t _setCrossover(duk_context * ctx)
+{
+    if( s_this == 0 )
+        return 0;
+    s_this->setCrossover(
+            duk_to_int(ctx,0), //int population
+            QString::fromUtf8(duk_safe_to_string(ctx,1)) //QString name
+                );
+    return 0;
+}
+
+static duk_ret_t _setSelection(duk_context * ctx)
+{
+    if( s_this == 0 )
+        return 0;
+    s_this->setSelection(
+            duk_to_int(ctx,0), //int population
+            QString::fromUtf8(duk_safe_to_string(ctx,1)), //QString name
+            duk_to_int(ctx,2) //int tournamentSize, 0 when not given
+                );
+    return 0;
+}
+
+static duk_ret_t _setGenomeCoding(duk_context * ctx)
+{
+    if( s_this == 0 )
+        return 0;
+    s_this->setGenomeCoding(
+            duk_to_int(ctx,0), //int population
+            QString::fromUtf8(duk_safe_to_string(ctx,1)) //QString name
+                );
+    return 0;
+}
+
+static duk_ret_t _setIslands(duk_context * ctx)
+{
+    if( s_this == 0 )
+        return 0;
+    s_this->setIslands(
+            duk_to_int(ctx,0), //int count
+            duk_is_undefined(ctx,1) ? 10 : duk_to_int(ctx,1), //int interval
+            duk_is_undefined(ctx,2) ? 1 : duk_to_int(ctx,2), //int migrants
+            duk_is_undefined(ctx,3) ? QString("Ring") : QString::fromUtf8(duk_safe_to_string(ctx,3)) //QString topology
+                );
+    return 0;
+}
+
+static duk_ret_t _setAdaptiveRates(duk_context * ctx)
+{
+    if( s_this == 0 )
+        return 0;
+    s_this->setAdaptiveRates(
+            duk_to_number(ctx,0) //float diversityTarget
+                );
+    return 0;
+}
+
+static duk_ret_t _setPlateauStop(duk_context * ctx)
+{
+    if( s_this == 0 )
+        return 0;
+    s_this->setPlateauStop(
+            duk_to_int(ctx,0), //int generations
+            duk_is_undefined(ctx,1) ? 0.0 : duk_to_number(ctx,1), //float epsilon, 0 when not given
+            duk_is_undefined(ctx,2) ? 0.0 : duk_to_number(ctx,2) //float diversity, 0 when not given
+                );
+    return 0;
+}
+
 static duk_ret_t _runEvo(duk_context * ctx)
 {
     if( s_this == 0 )
@@ -146,6 +234,24 @@ ScriptManager::ScriptManager()
     duk_push_c_function ( d_imp->engine , _setParams , 42 );
     duk_put_prop_string ( d_imp->engine , - 2 , "setParams" );
 
+    duk_push_c_function ( d_imp->engine , _setCrossover , 2 );
+    duk_put_prop_string ( d_imp->engine , - 2 , "setCrossover" );
+
+    duk_push_c_function ( d_imp->engine , _setSelection , 3 );
+    duk_put_prop_string ( d_imp->engine , - 2 , "setSelection" );
+
+    duk_push_c_function ( d_imp->engine , _setGenomeCoding , 2 );
+    duk_put_prop_string ( d_imp->engine , - 2 , "setGenomeCoding" );
+
+    duk_push_c_function ( d_imp->engine , _setIslands , 4 );
+    duk_put_prop_string ( d_imp->engine , - 2 , "setIslands" );
+
+    duk_push_c_function ( d_imp->engine , _setAdaptiveRates , 1 );
+    duk_put_prop_string ( d_imp->engine , - 2 , "setAdaptiveRates" );
+
+    duk_push_c_function ( d_imp->engine , _setPlateauStop , 3 );
+    duk_put_prop_string ( d_imp->engine , - 2 , "setPlateauStop" );
+
     duk_push_c_function ( d_imp->engine , _runEvo , 0 );
     duk_put_prop_string ( d_imp->engine , - 2 , "runEvo" );
 
@@ -171,6 +277,8 @@ void ScriptManager::run()
 {
     if( !d_imp->scriptReady )
         return;
+    if (SystemParameters::getInstance().hasBudget())
+        d_imp->countRuns();
     d_imp->doRun();
     emit scriptFinished();
 }
@@ -291,6 +399,163 @@ void ScriptManager::setParams(QString experimentName,
     sysParams.setThreshActivated(threshActivated);
 }
 
+/**
+  * Select the crossover of a population. This function may be called in the
+  * doSetParams() function of the script, the populations use the OnePoint
+  * crossover otherwise.
+  *
+  * @param population 1 for the membership functions, 2 for the rules.
+  * @param name OnePoint, TwoPoint, Uniform or RuleAligned.
+  */
+void ScriptManager::setCrossover(int population, QString name)
+{
+    SystemParameters& sysParams = SystemParameters::getInstance();
+
+    if (population == 1)
+        sysParams.setCrossoverPop1(name);
+    else if (population == 2)
+        sysParams.setCrossoverPop2(name);
+    else
+        std::cout << "Error : setCrossover() : no population " << population << std::endl;
+}
+
+/**
+  * Select the selection of the individuals to be reproduced in a population.
+  * This function may be called in the doSetParams() function of the script,
+  * the populations use a tournament of a tenth of the population otherwise.
+  *
+  * @param population 1 for the membership functions, 2 for the rules.
+  * @param name Tournament, RankBased, RouletteWheel, Proportional or TruncatedRank.
+  * @param tournamentSize Number of individuals of a tournament, 0 (or not given)
+  * for a tenth of the population.
+  */
+void ScriptManager::setSelection(int population, QString name, int tournamentSize)
+{
+    SystemParameters& sysParams = SystemParameters::getInstance();
+
+    if (tournamentSize < 0) {
+        std::cout << "Error : setSelection() : incorrect tournament size " << tournamentSize << std::endl;
+        tournamentSize = 0;
+    }
+    if (population == 1) {
+        sysParams.setSelectionPop1(name);
+        sysParams.setTournamentSizePop1(tournamentSize);
+    }
+    else if (population == 2) {
+        sysParams.setSelectionPop2(name);
+        sysParams.setTournamentSizePop2(tournamentSize);
+    }
+    else
+        std::cout << "Error : setSelection() : no population " << population << std::endl;
+}
+
+/**
+  * Select the coding of the genotypes of a population. This function may be
+  * called in the doSetParams() function of the script, the genotypes are bit
+  * strings otherwise.
+  *
+  * @param population 1 for the membership functions, 2 for the rules.
+  * @param name BitString, or Integer for a gene per position, variable or set
+  * number, which takes its valid values only.
+  */
+void ScriptManager::setGenomeCoding(int population, QString name)
+{
+    SystemParameters& sysParams = SystemParameters::getInstance();
+
+    bool integerCoded;
+    if (name.compare("Integer", Qt::CaseInsensitive) == 0)
+        integerCoded = true;
+    else if (name.compare("BitString", Qt::CaseInsensitive) == 0)
+        integerCoded = false;
+    else {
+        std::cout << "Error : setGenomeCoding() : unknown coding " << name.toStdString() << std::endl;
+        return;
+    }
+    if (population == 1)
+        sysParams.setIntegerCodedPop1(integerCoded);
+    else if (population == 2)
+        sysParams.setIntegerCodedPop2(integerCoded);
+    else
+        std::cout << "Error : setGenomeCoding() : no population " << population << std::endl;
+}
+
+/**
+  * Evolve several islands, each one a pair of populations of its own random
+  * stream, which exchange their best individuals. This function may be called
+  * in the doSetParams() function of the script, a single pair of populations
+  * is evolved otherwise.
+  *
+  * @param count Number of islands.
+  * @param interval Number of generations between two migrations (10 when not given).
+  * @param migrants Number of individuals sent by each population (1 when not given).
+  * @param topology Ring (the default), to the next island, or Random, to any other island.
+  */
+void ScriptManager::setIslands(int count, int interval, int migrants, QString topology)
+{
+    SystemParameters& sysParams = SystemParameters::getInstance();
+
+    if (count < 1) {
+        std::cout << "Error : setIslands() : incorrect number of islands " << count << std::endl;
+        return;
+    }
+    if (interval < 1 || migrants < 0) {
+        std::cout << "Error : setIslands() : incorrect migration " << migrants << " every " << interval << " generations" << std::endl;
+        return;
+    }
+    if (topology.compare("Ring", Qt::CaseInsensitive) != 0 && topology.compare("Random", Qt::CaseInsensitive) != 0) {
+        std::cout << "Error : setIslands() : unknown topology " << topology.toStdString() << std::endl;
+        return;
+    }
+    sysParams.setIslandCount(count);
+    sysParams.setMigrationInterval(interval);
+    sysParams.setMigrationSize(migrants);
+    sysParams.setMigrationTopology(topology);
+}
+
+/**
+  * Adapt the mutation per bit and the crossover rates of both populations to
+  * keep their diversity. This function may be called in the doSetParams()
+  * function of the script, the rates are fixed otherwise.
+  *
+  * @param diversityTarget Mean distance between two genotypes, divided by their
+  * length (about 0.5 for random genotypes), which the rates aim at. 0 keeps the rates.
+  */
+void ScriptManager::setAdaptiveRates(float diversityTarget)
+{
+    SystemParameters& sysParams = SystemParameters::getInstance();
+
+    if (diversityTarget < 0.0 || diversityTarget > 1.0) {
+        std::cout << "Error : setAdaptiveRates() : incorrect diversity target " << diversityTarget << std::endl;
+        return;
+    }
+    sysParams.setDiversityTarget(diversityTarget);
+}
+
+/**
+  * Stop the runs once the best fitness of each of their populations (of every
+  * island) stagnates. This function may be called in the doSetParams()
+  * function of the script, the runs last the number of generations of the
+  * script otherwise.
+  *
+  * @param generations Number of generations without improvement of a population before it is on a plateau, 0 to never stop.
+  * @param epsilon Smallest increase of the best fitness counted as an improvement (0 when not given).
+  * @param diversity Mean distance between two genotypes below which a population must
+  * also be to stop, 0 (or not given) for any diversity.
+  */
+void ScriptManager::setPlateauStop(int generations, float epsilon, float diversity)
+{
+    SystemParameters& sysParams = SystemParameters::getInstance();
+
+    if (generations < 0 || epsilon < 0.0 || diversity < 0.0) {
+        std::cout << "Error : setPlateauStop() : incorrect plateau of " << generations << " generations, epsilon "
+                  << epsilon << " and diversity " << diversity << std::endl;
+        return;
+    }
+    sysParams.setPlateauGenerations(generations);
+    sysParams.setPlateauEpsilon(epsilon);
+    sysParams.setPlateauDiversity(diversity);
+}
+
 /**
   * Read the contents of the script file.
   */
@@ -330,6 +595,8 @@ void ScriptManager::runScript()
         //QMessageBox::critical(0, "Error calling doRun", "The script has errors and cannot be run");
         return;
     }
+    if (SystemParameters::getInstance().hasBudget())
+        d_imp->countRuns();
     d_imp->doRun();
 }
 
@@ -343,6 +610,10 @@ bool ScriptManager::isScriptReady() const
   */
 void ScriptManager::runEvo()
 {
+    if (d_imp->countingRuns) {
+        d_imp->countedRuns++;
+        return;
+    }
     d_imp->doSetParams();
 
     emit startRun();
@@ -95,6 +95,12 @@ public slots:
                 float overLearnW,
                 float thresh,
                 bool threshActivated);
+    void setCrossover(int population, QString name);
+    void setSelection(int population, QString name, int tournamentSize = 0);
+    void setGenomeCoding(int population, QString name);
+    void setIslands(int count, int interval, int migrants, QString topology);
+    void setAdaptiveRates(float diversityTarget);
+    void setPlateauStop(int generations, float epsilon, float diversity);
 
 private:
     struct Imp;
@@ -27,6 +27,7 @@
 #include <iostream>
 
 #include <QFile>
+#include <QRandomGenerator>
 
 #include "systemparameters.h"
 
@@ -34,6 +35,14 @@ SystemParameters::SystemParameters()
 {
     fixedVars = false;
     verbose = false;
+    reducedPrecision = false;
+    datasetCache = false;
+    collapseDuplicates = false;
+    resumeGenerations = 0;
+    // Changed by --seed to reproduce a run
+    seed = QRandomGenerator::system()->generate64();
+    steadyState = false;
+    steadyStateLockstep = false;
     //MODIF - Bujard - 18.03.2010
     //MODIF - Bujard - 01.04.2010
     // Add some indice, usefull for regression problems
@@ -75,13 +84,36 @@ SystemParameters::SystemParameters()
     cxProbPop1 = -1.0;
     mutFlipIndPop1 = -1.0;
     mutFlipBitPop1 = -1.0;
+    crossoverPop1 = "OnePoint";
+    selectionPop1 = "Tournament";
+    tournamentSizePop1 = 0;
+    integerCodedPop1 = false;
     maxGenPop2 = -1;
     maxFitPop2 = 1.0;
     popSizePop2 = -1;
     cxProbPop2 = -1.0;
     mutFlipIndPop2 = -1.0;
     mutFlipBitPop2 = -1.0;
+    crossoverPop2 = "OnePoint";
+    selectionPop2 = "Tournament";
+    tournamentSizePop2 = 0;
+    integerCodedPop2 = false;
     nbCooperators = 2.0;
+    islandCount = 1;
+    migrationInterval = 10;
+    migrationSize = 1;
+    migrationTopology = "Ring";
+    diversityTarget = 0.0;
+    plateauGenerations = 0;
+    plateauEpsilon = 0.0;
+    plateauDiversity = 0.0;
+    // The budgets count from the start of the application
+    startClock.start();
+    timeBudget = 0;
+    evaluationBudget = 0;
+    plannedRuns = 1;
+    startedRuns = 0;
+    saveInterval = 0;
 }
 
 SystemParameters::~SystemParameters()
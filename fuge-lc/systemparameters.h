@@ -32,6 +32,7 @@
 
 #include <QObject>
 #include <QVector>
+#include <QElapsedTimer>
 
 class SystemParameters : public QObject
 {
@@ -52,6 +53,19 @@ private:
 
     // Verbose mode flag
     bool verbose;
+    // Reduced precision (fixed point) evaluation flag
+    bool reducedPrecision;
+    bool datasetCache;
+    bool collapseDuplicates;
+    // Run state file used to resume an evolution, and generations of a resumed run
+    QString runStateFile;
+    int resumeGenerations;
+    // Seed of the random streams of the runs
+    quint64 seed;
+    // Steady state evolution of the populations, instead of generations
+    bool steadyState;
+    // Steady state batches evaluated with the representatives of the same batch of the other population
+    bool steadyStateLockstep;
 
     //MODIF - Bujard - 18.03.2010
     // if regression parameters are activate
@@ -106,6 +120,10 @@ private:
     float cxProbPop1;
     float mutFlipIndPop1;
     float mutFlipBitPop1;
+    QString crossoverPop1;
+    QString selectionPop1;
+    int tournamentSizePop1;
+    bool integerCodedPop1;
 
     // Population 2 : Rules
     int maxGenPop2;
@@ -115,6 +133,38 @@ private:
     float cxProbPop2;
     float mutFlipIndPop2;
     float mutFlipBitPop2;
+    QString crossoverPop2;
+    QString selectionPop2;
+    int tournamentSizePop2;
+    bool integerCodedPop2;
+
+    // Island model : pairs of populations evolved side by side, and the
+    // migration of their best individuals every migrationInterval generations
+    int islandCount;
+    int migrationInterval;
+    int migrationSize;
+    QString migrationTopology;
+
+    // Diversity kept by adapting the mutation and crossover rates, 0 to keep them
+    float diversityTarget;
+
+    // Stop of the runs whose populations all have a best fitness which has not
+    // improved by more than plateauEpsilon for plateauGenerations generations
+    // (0 for never), and a diversity below plateauDiversity (0 for any diversity)
+    int plateauGenerations;
+    float plateauEpsilon;
+    float plateauDiversity;
+
+    // Time (in ms since the start) and evaluations given to all the runs of the
+    // script (0 for no limit), number of runs of the script they are shared
+    // between and number of those already started, and interval between the
+    // saves of the best system of a run (0 for none)
+    QElapsedTimer startClock;
+    qint64 timeBudget;
+    quint64 evaluationBudget;
+    int plannedRuns;
+    int startedRuns;
+    qint64 saveInterval;
 
 signals:
     void startRun();
@@ -131,6 +181,14 @@ public:
     inline void setDatasetName(QString name) {datasetName = name;}
     inline void setSavePath(QString path) {savePath = path;}
     inline void setVerbose(bool value) {verbose = value;}
+    inline void setReducedPrecision(bool value) {reducedPrecision = value;}
+    inline void setDatasetCache(bool value) {datasetCache = value;}
+    inline void setCollapseDuplicates(bool value) {collapseDuplicates = value;}
+    inline void setRunStateFile(QString fileName) {runStateFile = fileName;}
+    inline void setResumeGenerations(int value) {resumeGenerations = value;}
+    inline void setSeed(quint64 value) {seed = value;}
+    inline void setSteadyState(bool value) {steadyState = value;}
+    inline void setSteadyStateLockstep(bool value) {steadyStateLockstep = value;}
     inline void setFixedVars(bool value) {fixedVars = value;}
     //MODIF - Bujard - 18.03.2010
     // if regression parameters are activate
@@ -174,6 +232,10 @@ public:
     inline void setCxProbPop1(float value) {cxProbPop1 = value;}
     inline void setMutFlipIndPop1(float value) {mutFlipIndPop1 = value;}
     inline void setMutFlipBitPop1(float value) {mutFlipBitPop1 = value;}
+    inline void setCrossoverPop1(QString name) {crossoverPop1 = name;}
+    inline void setSelectionPop1(QString name) {selectionPop1 = name;}
+    inline void setTournamentSizePop1(int size) {tournamentSizePop1 = size;}
+    inline void setIntegerCodedPop1(bool value) {integerCodedPop1 = value;}
     inline void setMaxGenPop2(int value) {maxGenPop2 = value;}
     inline void setMaxFitPop2(float value) {maxFitPop2 = value;}
     inline void setEliteSizePop2(int value) {eliteSizePop2 = value;}
@@ -181,12 +243,37 @@ public:
     inline void setCxProbPop2(float value) {cxProbPop2 = value;}
     inline void setMutFlipIndPop2(float value) {mutFlipIndPop2 = value;}
     inline void setMutFlipBitPop2(float value) {mutFlipBitPop2 = value;}
+    inline void setCrossoverPop2(QString name) {crossoverPop2 = name;}
+    inline void setSelectionPop2(QString name) {selectionPop2 = name;}
+    inline void setTournamentSizePop2(int size) {tournamentSizePop2 = size;}
+    inline void setIntegerCodedPop2(bool value) {integerCodedPop2 = value;}
     inline void setNbCooperators(int value) {nbCooperators = value;}
+    inline void setIslandCount(int value) {islandCount = value;}
+    inline void setMigrationInterval(int value) {migrationInterval = value;}
+    inline void setMigrationSize(int value) {migrationSize = value;}
+    inline void setMigrationTopology(QString name) {migrationTopology = name;}
+    inline void setDiversityTarget(float value) {diversityTarget = value;}
+    inline void setPlateauGenerations(int value) {plateauGenerations = value;}
+    inline void setPlateauEpsilon(float value) {plateauEpsilon = value;}
+    inline void setPlateauDiversity(float value) {plateauDiversity = value;}
+    inline void setTimeBudget(qint64 value) {timeBudget = value;}
+    inline void setEvaluationBudget(quint64 value) {evaluationBudget = value;}
+    inline void setPlannedRuns(int value) {plannedRuns = value;}
+    inline void setStartedRuns(int value) {startedRuns = value;}
+    inline void setSaveInterval(qint64 value) {saveInterval = value;}
 
     inline QString getExperimentName() {return experimentName;}
     inline QString getDatasetName() {return datasetName;}
     inline QString getSavePath() {return savePath;}
     inline bool getVerbose() {return verbose;}
+    inline bool getReducedPrecision() {return reducedPrecision;}
+    inline bool getDatasetCache() {return datasetCache;}
+    inline bool getCollapseDuplicates() {return collapseDuplicates;}
+    inline QString getRunStateFile() {return runStateFile;}
+    inline int getResumeGenerations() {return resumeGenerations;}
+    inline quint64 getSeed() {return seed;}
+    inline bool getSteadyState() {return steadyState;}
+    inline bool getSteadyStateLockstep() {return steadyStateLockstep;}
     inline bool getFixedVars() {return fixedVars;}
     //MODIF - Bujard - 18.03.2010
     // if regression parameters are activate
@@ -231,6 +318,10 @@ public:
     inline float getCxProbPop1() {return cxProbPop1;}
     inline float getMutFlipIndPop1() {return mutFlipIndPop1;}
     inline float getMutFlipBitPop1() {return mutFlipBitPop1;}
+    inline QString getCrossoverPop1() {return crossoverPop1;}
+    inline QString getSelectionPop1() {return selectionPop1;}
+    inline int getTournamentSizePop1() {return tournamentSizePop1;}
+    inline bool getIntegerCodedPop1() {return integerCodedPop1;}
     inline int getMaxGenPop2() {return maxGenPop2;}
     inline float getMaxFitPop2() {return maxFitPop2;}
     inline int getEliteSizePop2() {return eliteSizePop2;}
@@ -238,7 +329,26 @@ public:
     inline float getCxProbPop2() {return cxProbPop2;}
     inline float getMutFlipIndPop2() {return mutFlipIndPop2;}
     inline float getMutFlipBitPop2() {return mutFlipBitPop2;}
+    inline QString getCrossoverPop2() {return crossoverPop2;}
+    inline QString getSelectionPop2() {return selectionPop2;}
+    inline int getTournamentSizePop2() {return tournamentSizePop2;}
+    inline bool getIntegerCodedPop2() {return integerCodedPop2;}
     inline int getNbCooperators() {return nbCooperators;}
+    inline int getIslandCount() {return islandCount;}
+    inline int getMigrationInterval() {return migrationInterval;}
+    inline int getMigrationSize() {return migrationSize;}
+    inline QString getMigrationTopology() {return migrationTopology;}
+    inline float getDiversityTarget() {return diversityTarget;}
+    inline int getPlateauGenerations() {return plateauGenerations;}
+    inline float getPlateauEpsilon() {return plateauEpsilon;}
+    inline float getPlateauDiversity() {return plateauDiversity;}
+    inline qint64 getElapsedTime() {return startClock.elapsed();}
+    inline qint64 getTimeBudget() {return timeBudget;}
+    inline quint64 getEvaluationBudget() {return evaluationBudget;}
+    inline bool hasBudget() {return timeBudget > 0 || evaluationBudget > 0;}
+    inline int getPlannedRuns() {return plannedRuns;}
+    inline int getStartedRuns() {return startedRuns;}
+    inline qint64 getSaveInterval() {return saveInterval;}
 };
 
 #endif // SYSTEMPARAMETERS_H
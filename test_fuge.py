@@ -37,7 +37,7 @@ if not os.path.exists(path_to_script_result + "evaluation"):
 # Run the fuge app to evaluate the fuzzy systems
 for fuzzy_sys_name in fuzzy_sys_names:
     path_to_result = path_to_script_result + "evaluation/" + fuzzy_sys_name
-    os.system(path_to_fuge_6_cmake + " --evaluate " + " -d " + path_to_dataset_arr + " -s " + path_to_script_arr + " -f " + path_to_fuzzy_systems + fuzzy_sys_name + " -g no > " + path_to_result + '\n')
+    os.system(path_to_fuge_6_cmake + " --evaluate --cache " + " -d " + path_to_dataset_arr + " -s " + path_to_script_arr + " -f " + path_to_fuzzy_systems + fuzzy_sys_name + " -g no > " + path_to_result + '\n')
 
  
 # read the result from result file, find the fitness and print it